@@ -206,6 +206,8 @@ void Scenery_Update(Scenery*);
 void Sprite_Update(Sprite*);
 void Item_Update(Item*);
 void Effect_Update(Effect*);
+bool Effect_IsIsolated(Effect*);
+void Effect_UpdateIsolated(Effect*);
 void TexturedLine_Update(TexturedLine*);
 void TexturedLine_UpdateAll(void);
 void Object_Update(void);
@@ -28,6 +28,9 @@ void Audio_InitSounds(void);
 void Audio_Update(void);
 SPTask* AudioThread_CreateTask(void);
 void AudioThread_PreNMIReset(void);
+// @port: offline rendering
+void Audio_ResetForRender(void);
+bool Audio_IsResetComplete(void);
 
 typedef enum AudioType {
     /* 0 */ AUDIO_TYPE_MUSIC,
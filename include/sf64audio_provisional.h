@@ -196,12 +196,21 @@ typedef struct AudioListItem {
     /* 0x0C */ struct NotePool* pool;
 } AudioListItem; // size = 0x10
 
+// @port: How many notes of each priority a note list holds, so its lowest priority is known without walking it
+typedef struct NotePriorityIndex {
+    /* 0x000 */ u64 present[4]; // a bit per priority with a nonzero count
+    /* 0x020 */ u8 counts[256];
+} NotePriorityIndex; // size = 0x120
+
 typedef struct NotePool {
     /* 0x00 */ AudioListItem disabled;
     /* 0x10 */ AudioListItem decaying;
     /* 0x20 */ AudioListItem releasing;
     /* 0x30 */ AudioListItem active;
-} NotePool; // size = 0x40
+    // @port: The lists notes are stolen from, see Audio_FindNodeWithPrioLessThan
+    /* 0x040 */ NotePriorityIndex releasingIndex;
+    /* 0x160 */ NotePriorityIndex activeIndex;
+} NotePool; // size = 0x280, 0x40 on N64
 
 // Pitch sliding by up to one octave in the positive direction. Negative
 // direction is "supported" by setting extent to be negative. The code
@@ -365,12 +374,12 @@ typedef struct {
     /* 0x074 */ SeqScriptState scriptState;
     /* 0x090 */ u8* shortNoteVelocityTable;
     /* 0x094 */ u8* shortNoteGateTimeTable;
-    /* 0x098 */ NotePool notePool;
-    /* 0x0D8 */ s32 skipTicks;
-    /* 0x0DC */ u32 scriptCounter;
-    /* 0x0E0 */ char
+    /* 0x098 */ NotePool notePool; // @port: members below are 0x240 further down than on N64
+    /* 0x2D8 */ s32 skipTicks;
+    /* 0x2DC */ u32 scriptCounter;
+    /* 0x2E0 */ char
         padE4[0x6C]; // unused struct members for sequence/sound font dma management, according to sm64 decomp
-} SequencePlayer;    // size = 0x14C
+} SequencePlayer;    // size = 0x350, 0x14C on N64
 
 typedef struct {
     /* 0x0 */ u8 decayIndex; // index used to obtain adsr decay rate from adsrDecayTable
@@ -478,10 +487,10 @@ typedef struct SequenceChannel {
     /* 0x48 */ struct SequenceLayer* layers[4];
     /* 0x58 */ SeqScriptState scriptState;
     /* 0x74 */ AdsrSettings adsr;
-    /* 0x7C */ NotePool notePool;
-    /* 0xBC */ s8 seqScriptIO[8]; // bridge between .seq script and audio lib, "io ports"
-    /* 0xC4 */ u16 unkC4;
-} SequenceChannel;                // size = 0xC8
+    /* 0x080 */ NotePool notePool;    // @port: at 0x7C on N64, aligned for NotePriorityIndex
+    /* 0x300 */ s8 seqScriptIO[8]; // bridge between .seq script and audio lib, "io ports"
+    /* 0x308 */ u16 unkC4;
+} SequenceChannel;                // size = 0x310, 0xC8 on N64
 
 // Might also be known as a Track, according to sm64 debug strings (?).
 typedef struct SequenceLayer {
@@ -538,12 +547,12 @@ typedef struct {
     /* 0x020 */ s16 finalResampleState[16];
     /* 0x040 */ UnkStruct_800097A8 unk_40;
     /* 0x060 */ char pad[0x20];
-    /* 0x080 */ s16 panSamplesBuffer[0x20];
+    /* 0x080 */ s16 panSamplesBuffer[0x30]; // @port: 0x20 on N64, grown for the Haas effect delay at 48 kHz
     // /* 0x040 */ s16 mixEnvelopeState[32];
     // /* 0x080 */ s16 unusedState[16];
     // /* 0x0A0 */ s16 haasEffectDelayState[32];
     // /* 0x0E0 */ s16 combFilterState[128];
-} NoteSynthesisBuffers; // size = 0xC0
+} NoteSynthesisBuffers; // size = 0xE0, 0xC0 on N64
 
 typedef struct {
     /* 0x00 */ u8 restart;
@@ -1074,6 +1083,8 @@ void AudioLoad_SyncInitSeqPlayer(s32 playerIdx, s32 seqId, s32 arg2);
 void* AudioLoad_DmaSampleData(uintptr_t devAddr, u32 size, u32 arg2, u8* dmaIndexRef, s32 medium);
 void AudioLoad_InitSampleDmaBuffers(s32 numNotes);
 void AudioLoad_SyncLoadSeqParts(s32 seqId, s32 flags);
+s32 AudioLoad_SeqFontsLoaded(s32 seqId);
+s32 AudioLoad_GetFontLoadStatus(s32 fontId, void* fontData);
 s32 AudioLoad_SyncLoadInstrument(s32 fontId, s32 instId, s32 drumId);
 void AudioLoad_AsyncLoadSampleBank(s32 sampleBankId, s32 nChunks, s32 retData, OSMesgQueue* retQueue);
 void AudioLoad_AsyncLoadSeq(s32 seqId, s32 nChunks, s32 retData, OSMesgQueue* retQueue);
@@ -1094,6 +1105,8 @@ void Audio_InitNoteFreeList(void);
 void Audio_NotePoolClear(NotePool* pool);
 void Audio_NotePoolFill(NotePool* pool, s32);
 void Audio_AudioListRemove(Note* note);
+void Audio_SetNotePriority(Note* note, s32 priority);
+void Audio_SetNoteList(Note* note, AudioListItem* list);
 Note* Audio_AllocNote(SequenceLayer* layer);
 void Audio_NoteInitAll(void);
 
@@ -15,6 +15,13 @@ bool AudioPlayer::IsInitialized() {
     return mInitialized;
 }
 
+AudioPlayerStats AudioPlayer::GetStats() {
+    AudioPlayerStats stats;
+    stats.Buffered = Buffered();
+    stats.TargetBuffered = GetDesiredBuffered();
+    return stats;
+}
+
 int32_t AudioPlayer::GetSampleRate() const {
     return mAudioSettings.SampleRate;
 }
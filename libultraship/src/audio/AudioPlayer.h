@@ -13,6 +13,20 @@ struct AudioSettings {
     AudioChannelsSetting AudioSurround = AudioChannelsSetting::audioStereo;
 };
 
+struct AudioPlayerStats {
+    // Samples per channel queued for the device, and the level the player tries to keep
+    int32_t Buffered = 0;
+    int32_t TargetBuffered = 0;
+    // Frames that found the queue empty, and frames dropped because the queue was too full
+    uint32_t Underruns = 0;
+    uint32_t Overruns = 0;
+    // Playback rate relative to the sample rate, used to steer the queue towards its target
+    float RateCorrection = 1.0f;
+    // Rate the device runs at and the samples per channel it holds past the queue, 0 when the player can't tell
+    int32_t DeviceSampleRate = 0;
+    int32_t DeviceBuffered = 0;
+};
+
 class AudioPlayer {
 
   public:
@@ -26,6 +40,8 @@ class AudioPlayer {
 
     bool IsInitialized();
 
+    virtual AudioPlayerStats GetStats();
+
     int32_t GetSampleRate() const;
 
     int32_t GetSampleLength() const;
@@ -1,8 +1,22 @@
 #include "SDLAudioPlayer.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
 
 namespace Ship {
 
+// How fast the controller follows the queue level. Frames arrive in bursts with some jitter, so the level is
+// averaged over a few dozen frames before it steers the rate.
+static constexpr float LEVEL_SMOOTHING = 0.05f;
+// Rate correction per unit of relative error from the target, and its limit. Half a percent is well below what
+// anyone hears as a pitch change, and plenty to absorb the drift between the video and audio clocks.
+static constexpr float CORRECTION_GAIN = 0.005f;
+static constexpr float MAX_CORRECTION = 0.005f;
+// The correction is only passed on to SDL when it moves by more than this
+static constexpr float CORRECTION_STEP = 0.0001f;
+// Past this many times the target the queue is too far ahead to catch up by resampling, and frames are dropped
+static constexpr int32_t OVERRUN_FACTOR = 4;
+
 SDLAudioPlayer::~SDLAudioPlayer() {
     SPDLOG_TRACE("destruct SDL audio player");
     if (mAudioStream) {
@@ -60,9 +74,53 @@ void SDLAudioPlayer::Play(const uint8_t* buf, size_t len) {
     if (!mAudioStream) {
         return;
     }
-    if (Buffered() < 6000) {
+
+    const int32_t buffered = Buffered();
+    const int32_t target = std::max(GetDesiredBuffered(), 1);
+
+    if (buffered == 0 && mStarted) {
+        // The device ran dry before this frame arrived
+        mUnderruns++;
+    }
+    mStarted = true;
+
+    if (buffered >= std::max(target * OVERRUN_FACTOR, GetSampleRate() / 8)) {
         // Don't fill the audio buffer too much in case this happens
-        SDL_PutAudioStreamData(mAudioStream, buf, len);
+        mOverruns++;
+        return;
+    }
+
+    // Steer the queue towards the target by playing slightly faster when it holds too much and slightly slower when
+    // it holds too little, instead of dropping or repeating whole frames.
+    if (mSmoothedBuffered < 0.0f) {
+        mSmoothedBuffered = (float)buffered;
+    } else {
+        mSmoothedBuffered += ((float)buffered - mSmoothedBuffered) * LEVEL_SMOOTHING;
+    }
+    const float error = (mSmoothedBuffered - (float)target) / (float)target;
+    const float correction = 1.0f + std::clamp(error * CORRECTION_GAIN, -MAX_CORRECTION, MAX_CORRECTION);
+    if (std::fabs(correction - mRateCorrection.load()) > CORRECTION_STEP) {
+        if (SDL_SetAudioStreamFrequencyRatio(mAudioStream, correction)) {
+            mRateCorrection = correction;
+        }
+    }
+
+    SDL_PutAudioStreamData(mAudioStream, buf, len);
+}
+
+AudioPlayerStats SDLAudioPlayer::GetStats() {
+    AudioPlayerStats stats = AudioPlayer::GetStats();
+    stats.Underruns = mUnderruns;
+    stats.Overruns = mOverruns;
+    stats.RateCorrection = mRateCorrection;
+
+    SDL_AudioSpec deviceSpec;
+    int deviceFrames = 0;
+    if (mAudioStream != nullptr &&
+        SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(mAudioStream), &deviceSpec, &deviceFrames)) {
+        stats.DeviceSampleRate = deviceSpec.freq;
+        stats.DeviceBuffered = deviceFrames;
     }
+    return stats;
 }
 } // namespace Ship
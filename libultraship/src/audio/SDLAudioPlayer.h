@@ -1,6 +1,7 @@
 #pragma once
 #include "AudioPlayer.h"
 #include <SDL3/SDL.h>
+#include <atomic>
 
 namespace Ship {
 class SDLAudioPlayer final : public AudioPlayer {
@@ -11,6 +12,7 @@ class SDLAudioPlayer final : public AudioPlayer {
 
     int Buffered();
     void Play(const uint8_t* buf, size_t len);
+    AudioPlayerStats GetStats();
 
   protected:
     bool DoInit();
@@ -18,5 +20,12 @@ class SDLAudioPlayer final : public AudioPlayer {
   private:
     SDL_AudioStream* mAudioStream = nullptr;
     int32_t mNumChannels = 2;
+
+    // Latency controller state, see Play. The counters are read by the UI thread.
+    float mSmoothedBuffered = -1.0f;
+    bool mStarted = false;
+    std::atomic<uint32_t> mUnderruns = 0;
+    std::atomic<uint32_t> mOverruns = 0;
+    std::atomic<float> mRateCorrection = 1.0f;
 };
 } // namespace Ship
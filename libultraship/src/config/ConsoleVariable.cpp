@@ -1,6 +1,8 @@
 #include "ConsoleVariable.h"
+#include "public/bridge/consolevariablebridge.h"
 
 #include <functional>
+#include <vector>
 #include "utils/filesystemtools/DiskFile.h"
 #include <utils/Utils.h>
 #include "config/LibUltrashipConfig.h"
@@ -10,8 +12,13 @@
 #define strdup _strdup
 #endif
 
+uint32_t gCVarVersion = 0;
+
 namespace Ship {
 
+static_assert(CVAR_SLOT_INTEGER == static_cast<int32_t>(ConsoleVariableType::Integer));
+static_assert(CVAR_SLOT_FLOAT == static_cast<int32_t>(ConsoleVariableType::Float));
+
 ConsoleVariable::ConsoleVariable() {
     Load();
 }
@@ -96,6 +103,7 @@ void ConsoleVariable::SetInteger(const char* name, int32_t value) {
 
     variable->Type = ConsoleVariableType::Integer;
     variable->Integer = value;
+    SyncSlot(name);
 }
 
 void ConsoleVariable::SetFloat(const char* name, float value) {
@@ -106,6 +114,7 @@ void ConsoleVariable::SetFloat(const char* name, float value) {
 
     variable->Type = ConsoleVariableType::Float;
     variable->Float = value;
+    SyncSlot(name);
 }
 
 void ConsoleVariable::SetString(const char* name, const char* value) {
@@ -119,6 +128,7 @@ void ConsoleVariable::SetString(const char* name, const char* value) {
         free(variable->String);
     }
     variable->String = strdup(value);
+    SyncSlot(name);
 }
 
 void ConsoleVariable::SetColor(const char* name, Color_RGBA8 value) {
@@ -129,6 +139,7 @@ void ConsoleVariable::SetColor(const char* name, Color_RGBA8 value) {
 
     variable->Type = ConsoleVariableType::Color;
     variable->Color = value;
+    SyncSlot(name);
 }
 
 void ConsoleVariable::SetColor24(const char* name, Color_RGB8 value) {
@@ -139,6 +150,7 @@ void ConsoleVariable::SetColor24(const char* name, Color_RGB8 value) {
 
     variable->Type = ConsoleVariableType::Color24;
     variable->Color24 = value;
+    SyncSlot(name);
 }
 
 void ConsoleVariable::RegisterInteger(const char* name, int32_t defaultValue) {
@@ -187,6 +199,11 @@ void ConsoleVariable::ClearVariable(const char* name) {
             mVariables.erase(g);
             mVariables.erase(r);
             mVariables.erase(t);
+            SyncSlot(a);
+            SyncSlot(b);
+            SyncSlot(g);
+            SyncSlot(r);
+            SyncSlot(t);
             conf->Erase(std::string("CVars.") + a);
             conf->Erase(std::string("CVars.") + b);
             conf->Erase(std::string("CVars.") + g);
@@ -198,6 +215,7 @@ void ConsoleVariable::ClearVariable(const char* name) {
         }
     }
     mVariables.erase(name);
+    SyncSlot(name);
     conf->Erase(StringHelper::Sprintf("CVars.%s", name));
 }
 
@@ -238,6 +256,65 @@ void ConsoleVariable::CopyVariable(const char* from, const char* to) {
             variableTo->Color24 = variableFrom->Color24;
             break;
     }
+    SyncSlot(to);
+}
+
+CVarSlot* ConsoleVariable::GetSlot(const char* name) {
+    CVarSlot* slot;
+
+    {
+        std::lock_guard<std::mutex> lock(mSlotsMutex);
+        auto& entry = mSlots[name];
+        if (entry != nullptr) {
+            return entry.get();
+        }
+        entry = std::make_unique<CVarSlot>();
+        entry->Type = CVAR_SLOT_UNSET;
+        entry->Integer = 0;
+        slot = entry.get();
+    }
+
+    SyncSlot(name);
+    return slot;
+}
+
+void ConsoleVariable::SyncSlot(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mSlotsMutex);
+    gCVarVersion++;
+
+    auto slot = mSlots.find(name);
+    if (slot == mSlots.end()) {
+        return;
+    }
+
+    auto variable = mVariables.find(name);
+    if (variable == mVariables.end()) {
+        slot->second->Type = CVAR_SLOT_UNSET;
+    } else if (variable->second->Type == ConsoleVariableType::Integer) {
+        slot->second->Integer = variable->second->Integer;
+        slot->second->Type = CVAR_SLOT_INTEGER;
+    } else if (variable->second->Type == ConsoleVariableType::Float) {
+        slot->second->Float = variable->second->Float;
+        slot->second->Type = CVAR_SLOT_FLOAT;
+    } else {
+        slot->second->Type = CVAR_SLOT_UNSET;
+    }
+}
+
+void ConsoleVariable::SyncAllSlots() {
+    std::vector<std::string> names;
+
+    {
+        std::lock_guard<std::mutex> lock(mSlotsMutex);
+        names.reserve(mSlots.size());
+        for (const auto& slot : mSlots) {
+            names.push_back(slot.first);
+        }
+    }
+
+    for (const auto& name : names) {
+        SyncSlot(name);
+    }
 }
 
 void ConsoleVariable::Save() {
@@ -286,6 +363,8 @@ void ConsoleVariable::Load() {
     LoadFromPath("", conf->GetNestedJson()["CVars"].items());
 
     LoadLegacy();
+    // Variables that were dropped by the reload have to read as unset again
+    SyncAllSlots();
 }
 
 void ConsoleVariable::LoadFromPath(
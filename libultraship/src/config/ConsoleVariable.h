@@ -4,9 +4,12 @@
 #include <nlohmann/json.hpp>
 #include <stdint.h>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 
+struct CVarSlot;
+
 namespace Ship {
 typedef enum class ConsoleVariableType { Integer, Float, String, Color, Color24 } ConsoleVariableType;
 
@@ -55,6 +58,9 @@ class ConsoleVariable {
     void ClearBlock(const char* name);
     void CopyVariable(const char* from, const char* to);
 
+    // Returns the stable slot mirroring a numeric CVar, creating it on first use.
+    CVarSlot* GetSlot(const char* name);
+
     void Save();
     void Load();
 
@@ -64,6 +70,13 @@ class ConsoleVariable {
     void LoadLegacy();
 
   private:
+    void SyncSlot(const std::string& name);
+    void SyncAllSlots();
+
     std::unordered_map<std::string, std::shared_ptr<CVar>> mVariables;
+    // Never erased, handles given out to C code point straight into these.
+    std::unordered_map<std::string, std::unique_ptr<CVarSlot>> mSlots;
+    // Handles are resolved from both the game and the audio thread
+    std::mutex mSlotsMutex;
 };
 } // namespace Ship
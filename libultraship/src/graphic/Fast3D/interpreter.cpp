@@ -521,6 +521,22 @@ void Interpreter::TextureCacheDelete(const uint8_t* origAddr) {
     }
 }
 
+// Drops every texture that was imported from addr or uses it as a palette, for when the memory is freed and can be
+// handed out again
+void Interpreter::TextureCacheEvict(const uint8_t* addr) {
+    TextureCacheDelete(addr);
+
+    for (auto it = mTextureCache.map.begin(); it != mTextureCache.map.end();) {
+        if (it->first.palette_addrs[0] == addr || it->first.palette_addrs[1] == addr) {
+            mTextureCache.lru.erase(it->second.lru_location);
+            mTextureCache.free_texture_ids.push_back(it->second.texture_id);
+            it = mTextureCache.map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void Interpreter::ImportTextureRgba16(int tile, bool importReplacement) {
     const RawTexMetadata* metadata = &mRdp->loaded_texture[mRdp->texture_tile[tile].tmem_index].raw_tex_metadata;
     const uint8_t* addr =
@@ -2971,7 +2987,7 @@ int16_t Interpreter::CreateShader(const std::string& path) {
     if (shader == nullptr || !shader->IsLoaded) {
         return -1;
     }
-    shader_ids.push_back(std::string(shader->Buffer->data()));
+    shader_ids.push_back(std::string(shader->GetData(), strnlen(shader->GetData(), shader->GetSize())));
     return shader_ids.size() - 1;
 }
 
@@ -4703,3 +4719,7 @@ extern "C" int gfx_create_framebuffer(uint32_t width, uint32_t height, uint32_t
 extern "C" void gfx_texture_cache_clear() {
     Fast::mInstance.lock().get()->TextureCacheClear();
 }
+
+extern "C" void gfx_texture_cache_evict(const uint8_t* addr) {
+    Fast::mInstance.lock().get()->TextureCacheEvict(addr);
+}
@@ -85,4 +85,8 @@ void CVarLoad() {
 void CVarSave() {
     Ship::Context::GetInstance()->GetConsoleVariables()->Save();
 }
+
+CVarHandle CVarGetHandle(const char* name) {
+    return Ship::Context::GetInstance()->GetConsoleVariables()->GetSlot(name);
+}
 }
@@ -4,8 +4,25 @@
 #define _CONSOLEVARIABLEBRIDGE_H
 
 #include "stdint.h"
+#include "stddef.h"
 #include "libultraship/color.h"
 
+#define CVAR_SLOT_UNSET -1
+#define CVAR_SLOT_INTEGER 0
+#define CVAR_SLOT_FLOAT 1
+
+// Numeric view of a CVar that stays at the same address for the lifetime of the program.
+// Type is CVAR_SLOT_UNSET when the CVar does not exist or is not a number.
+typedef struct CVarSlot {
+    int32_t Type;
+    union {
+        int32_t Integer;
+        float Float;
+    };
+} CVarSlot;
+
+typedef const CVarSlot* CVarHandle;
+
 #ifdef __cplusplus
 #include <memory>
 #include <config/ConsoleVariable.h>
@@ -40,6 +57,40 @@ void CVarCopy(const char* from, const char* to);
 void CVarLoad();
 void CVarSave();
 
+// Bumped on every CVar change, so derived values can be cached until it moves.
+extern uint32_t gCVarVersion;
+
+// Resolves a CVar once for repeated reads. The handle stays valid when the CVar is cleared,
+// reloaded or created later on, it then reads as the default value passed to the getters below.
+CVarHandle CVarGetHandle(const char* name);
+
+static inline uint32_t CVarGetVersion(void) {
+    return gCVarVersion;
+}
+
+static inline int32_t CVarHandleGetInteger(CVarHandle handle, int32_t defaultValue) {
+    return handle->Type == CVAR_SLOT_INTEGER ? handle->Integer : defaultValue;
+}
+
+static inline float CVarHandleGetFloat(CVarHandle handle, float defaultValue) {
+    return handle->Type == CVAR_SLOT_FLOAT ? handle->Float : defaultValue;
+}
+
+// Drop-in replacements for CVarGetInteger/CVarGetFloat that resolve the name into *handle on first use.
+static inline int32_t CVarGetCachedInteger(CVarHandle* handle, const char* name, int32_t defaultValue) {
+    if (*handle == NULL) {
+        *handle = CVarGetHandle(name);
+    }
+    return CVarHandleGetInteger(*handle, defaultValue);
+}
+
+static inline float CVarGetCachedFloat(CVarHandle* handle, const char* name, float defaultValue) {
+    if (*handle == NULL) {
+        *handle = CVarGetHandle(name);
+    }
+    return CVarHandleGetFloat(*handle, defaultValue);
+}
+
 #ifdef __cplusplus
 };
 #endif
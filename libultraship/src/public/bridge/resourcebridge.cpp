@@ -201,4 +201,8 @@ void ResourceUnloadDirectory(const char* name) {
 uint32_t IsResourceManagerLoaded() {
     return Ship::Context::GetInstance()->GetResourceManager()->IsLoaded();
 }
+
+uint32_t ResourceGetCacheGeneration() {
+    return Ship::Context::GetInstance()->GetResourceManager()->GetCacheGeneration();
+}
 }
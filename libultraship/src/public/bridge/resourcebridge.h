@@ -48,6 +48,7 @@ void ResourceClearCache();
 void ResourceGetGameVersions(uint32_t* versions, size_t versionsSize, size_t* versionsCount);
 uint32_t ResourceHasGameVersion(uint32_t hash);
 uint32_t IsResourceManagerLoaded();
+uint32_t ResourceGetCacheGeneration();
 
 #ifdef __cplusplus
 };
@@ -32,7 +32,20 @@ struct ResourceInitData {
 
 struct File {
     std::shared_ptr<std::vector<char>> Buffer;
+    // A file can also be a view into memory owned by Storage, e.g. a memory-mapped archive or a Buffer
+    // with the resource header skipped. When Data is set it takes precedence over Buffer.
+    std::shared_ptr<void> Storage;
+    char* Data = nullptr;
+    size_t Size = 0;
     std::variant<std::shared_ptr<tinyxml2::XMLDocument>, std::shared_ptr<BinaryReader>> Reader;
     bool IsLoaded = false;
+
+    char* GetData() const {
+        return Data != nullptr ? Data : (Buffer != nullptr ? Buffer->data() : nullptr);
+    }
+
+    size_t GetSize() const {
+        return Data != nullptr ? Size : (Buffer != nullptr ? Buffer->size() : 0);
+    }
 };
 } // namespace Ship
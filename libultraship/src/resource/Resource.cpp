@@ -20,4 +20,36 @@ void IResource::Dirty() {
 std::shared_ptr<ResourceInitData> IResource::GetInitData() {
     return mInitData;
 }
+
+void IResource::AddDependency(std::shared_ptr<IResource> dependency) {
+    mDependencies.push_back(std::move(dependency));
+}
+
+size_t IResource::GetMemorySize() {
+    return mMemorySize;
+}
+
+void IResource::SetMemorySize(size_t size) {
+    mMemorySize = size;
+}
+
+uint32_t IResource::GetLoadEpoch() {
+    return mLoadEpoch;
+}
+
+uint32_t IResource::GetLastUseEpoch() {
+    return mLastUseEpoch.load(std::memory_order_relaxed);
+}
+
+void IResource::SetLoadEpoch(uint32_t epoch) {
+    mLoadEpoch = epoch;
+    mLastUseEpoch.store(epoch, std::memory_order_relaxed);
+}
+
+void IResource::MarkUsed(uint32_t epoch) {
+    // Most hits are in the current epoch already, skip the store so the cache line stays shared
+    if (mLastUseEpoch.load(std::memory_order_relaxed) != epoch) {
+        mLastUseEpoch.store(epoch, std::memory_order_relaxed);
+    }
+}
 } // namespace Ship
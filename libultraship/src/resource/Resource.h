@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <vector>
 #include "resource/File.h"
 
 namespace Ship {
@@ -19,9 +21,26 @@ class IResource {
     void Dirty();
     std::shared_ptr<ResourceInitData> GetInitData();
 
+    // Keeps a resource this one points into loaded for as long as this one is
+    void AddDependency(std::shared_ptr<IResource> dependency);
+
+    // Bytes the resource counts for against the resource manager's memory budget
+    size_t GetMemorySize();
+    void SetMemorySize(size_t size);
+    // Memory epoch the resource was loaded in and the last one it was handed out in, see
+    // ResourceManager::BeginMemoryEpoch
+    uint32_t GetLoadEpoch();
+    uint32_t GetLastUseEpoch();
+    void SetLoadEpoch(uint32_t epoch);
+    void MarkUsed(uint32_t epoch);
+
   private:
     std::shared_ptr<ResourceInitData> mInitData;
     bool mIsDirty = false;
+    std::vector<std::shared_ptr<IResource>> mDependencies;
+    size_t mMemorySize = 0;
+    uint32_t mLoadEpoch = 0;
+    std::atomic<uint32_t> mLastUseEpoch = 0;
 };
 
 template <class T> class Resource : public IResource {
@@ -17,4 +17,11 @@ bool ResourceFactoryBinary::FileHasValidFormatAndReader(std::shared_ptr<File> fi
 
     return true;
 };
+
+SpanReader ResourceFactoryBinary::CreateSpanReader(std::shared_ptr<File> file,
+                                                   std::shared_ptr<Ship::ResourceInitData> initData) {
+    SpanReader reader(file->GetData(), file->GetSize(), initData->ByteOrder);
+    reader.Seek(std::get<std::shared_ptr<BinaryReader>>(file->Reader)->GetBaseAddress());
+    return reader;
+}
 } // namespace Ship
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "ResourceFactory.h"
+#include "utils/binarytools/SpanReader.h"
 
 namespace Ship {
 class ResourceFactoryBinary : public ResourceFactory {
   protected:
     bool FileHasValidFormatAndReader(std::shared_ptr<File> file,
                                      std::shared_ptr<Ship::ResourceInitData> initData) override;
+
+    // Reader over the file's data at the binary reader's position, for factories that read many values.
+    // The file has to outlive it.
+    static SpanReader CreateSpanReader(std::shared_ptr<File> file, std::shared_ptr<Ship::ResourceInitData> initData);
 };
 } // namespace Ship
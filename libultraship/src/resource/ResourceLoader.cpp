@@ -5,6 +5,7 @@
 #include "File.h"
 #include "Context.h"
 #include "utils/binarytools/MemoryStream.h"
+#include "utils/binarytools/ViewStream.h"
 #include "utils/binarytools/BinaryReader.h"
 #include "factory/JsonFactory.h"
 #include "factory/ShaderFactory.h"
@@ -13,6 +14,14 @@
 #include "nlohmann/json.hpp"
 
 namespace Ship {
+static std::shared_ptr<Stream> CreateFileStream(std::shared_ptr<File> file) {
+    if (file->Data != nullptr) {
+        return std::make_shared<ViewStream>(file->Storage, file->Data, file->Size);
+    }
+
+    return std::make_shared<MemoryStream>(file->Buffer);
+}
+
 ResourceLoader::ResourceLoader() {
     RegisterGlobalResourceFactories();
 }
@@ -84,11 +93,16 @@ std::shared_ptr<ResourceFactory> ResourceLoader::GetFactory(uint32_t format, std
 
 std::shared_ptr<ResourceInitData> ResourceLoader::ReadResourceInitDataLegacy(const std::string& filePath,
                                                                              std::shared_ptr<File> fileToLoad) {
+    if (fileToLoad->GetSize() == 0) {
+        SPDLOG_ERROR("Failed to parse ResourceInitData, file {} is empty.", filePath);
+        return nullptr;
+    }
+
     // Determine if file is binary or XML...
-    if (fileToLoad->Buffer->at(0) == '<') {
+    if (fileToLoad->GetData()[0] == '<') {
         // File is XML
         // Read the xml document
-        auto stream = std::make_shared<MemoryStream>(fileToLoad->Buffer);
+        auto stream = CreateFileStream(fileToLoad);
         auto binaryReader = std::make_shared<BinaryReader>(stream);
 
         auto xmlReader = std::make_shared<tinyxml2::XMLDocument>();
@@ -100,31 +114,36 @@ std::shared_ptr<ResourceInitData> ResourceLoader::ReadResourceInitDataLegacy(con
         }
         return ReadResourceInitDataXml(filePath, xmlReader);
     } else {
-        auto headerBuffer = std::make_shared<std::vector<char>>(fileToLoad->Buffer->begin(),
-                                                                fileToLoad->Buffer->begin() + OTR_HEADER_SIZE);
-
-        if (headerBuffer->size() < OTR_HEADER_SIZE) {
+        if (fileToLoad->GetSize() < OTR_HEADER_SIZE) {
             SPDLOG_ERROR("Failed to parse ResourceInitData, buffer size too small. File: {}. Got {} bytes and "
                          "needed {} bytes.",
-                         filePath, headerBuffer->size(), OTR_HEADER_SIZE);
+                         filePath, fileToLoad->GetSize(), OTR_HEADER_SIZE);
             return nullptr;
         }
 
-        // Factories expect the buffer to not include the header,
-        // so we need to remove it from the buffer on the file
-        fileToLoad->Buffer = std::make_shared<std::vector<char>>(fileToLoad->Buffer->begin() + OTR_HEADER_SIZE,
-                                                                 fileToLoad->Buffer->end());
-
-        // Create a reader for the header buffer
-        auto headerStream = std::make_shared<MemoryStream>(headerBuffer);
+        // Create a reader for the header
+        auto headerStream = std::make_shared<ViewStream>(nullptr, fileToLoad->GetData(), OTR_HEADER_SIZE);
         auto headerReader = std::make_shared<BinaryReader>(headerStream);
-        return ReadResourceInitDataBinary(filePath, headerReader);
+        auto initData = ReadResourceInitDataBinary(filePath, headerReader);
+
+        // Factories expect the data to not include the header, so the file becomes a view past it.
+        // The data stays where it is, the buffer is kept alive as the view's storage.
+        char* data = fileToLoad->GetData() + OTR_HEADER_SIZE;
+        size_t size = fileToLoad->GetSize() - OTR_HEADER_SIZE;
+        if (fileToLoad->Data == nullptr) {
+            fileToLoad->Storage = fileToLoad->Buffer;
+        }
+        fileToLoad->Data = data;
+        fileToLoad->Size = size;
+        fileToLoad->Buffer = nullptr;
+
+        return initData;
     }
 }
 
 std::shared_ptr<BinaryReader> ResourceLoader::CreateBinaryReader(std::shared_ptr<File> fileToLoad,
                                                                  std::shared_ptr<ResourceInitData> initData) {
-    auto stream = std::make_shared<MemoryStream>(fileToLoad->Buffer);
+    auto stream = CreateFileStream(fileToLoad);
     auto reader = std::make_shared<BinaryReader>(stream);
     reader->SetEndianness(initData->ByteOrder);
     return reader;
@@ -132,7 +151,7 @@ std::shared_ptr<BinaryReader> ResourceLoader::CreateBinaryReader(std::shared_ptr
 
 std::shared_ptr<tinyxml2::XMLDocument> ResourceLoader::CreateXMLReader(std::shared_ptr<File> fileToLoad,
                                                                        std::shared_ptr<ResourceInitData> initData) {
-    auto stream = std::make_shared<MemoryStream>(fileToLoad->Buffer);
+    auto stream = CreateFileStream(fileToLoad);
     auto binaryReader = std::make_shared<BinaryReader>(stream);
 
     auto xmlReader = std::make_shared<tinyxml2::XMLDocument>();
@@ -164,7 +183,7 @@ std::shared_ptr<ResourceInitData> ResourceLoader::ReadResourceInitData(const std
     // just using metaFileToLoad->Buffer->data() leads to garbage at the end
     // that causes nlohmann to fail parsing, following the pattern used for
     // xml resolves that issue
-    auto stream = std::make_shared<MemoryStream>(metaFileToLoad->Buffer);
+    auto stream = CreateFileStream(metaFileToLoad);
     auto binaryReader = std::make_shared<BinaryReader>(stream);
     auto parsed = nlohmann::json::parse(binaryReader->ReadCString());
 
@@ -234,6 +253,15 @@ uint32_t ResourceLoader::GetResourceType(const std::string& type) {
     return mResourceTypes.contains(type) ? mResourceTypes[type] : static_cast<uint32_t>(ResourceType::None);
 }
 
+std::string ResourceLoader::GetResourceTypeName(uint32_t type) {
+    for (const auto& [name, value] : mResourceTypes) {
+        if (value == type) {
+            return name;
+        }
+    }
+    return DecodeASCII(type);
+}
+
 std::shared_ptr<ResourceInitData>
 ResourceLoader::ReadResourceInitDataBinary(const std::string& filePath, std::shared_ptr<BinaryReader> headerReader) {
     auto resourceInitData = CreateDefaultResourceInitData();
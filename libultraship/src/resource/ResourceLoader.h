@@ -38,6 +38,7 @@ class ResourceLoader {
                                  uint32_t type, uint32_t version);
 
     uint32_t GetResourceType(const std::string& type);
+    std::string GetResourceTypeName(uint32_t type);
 
   protected:
     void RegisterGlobalResourceFactories();
@@ -6,6 +6,7 @@
 #include <thread>
 #include "utils/StringHelper.h"
 #include "utils/Utils.h"
+#include "utils/StrHash64.h"
 #include "public/bridge/consolevariablebridge.h"
 #include "Context.h"
 
@@ -22,18 +23,20 @@ size_t ResourceIdentifier::GetHash() const {
 
 ResourceIdentifier::ResourceIdentifier(const std::string& path, const uintptr_t owner,
                                        const std::shared_ptr<Archive> parent)
-    : Path(path), Owner(owner), Parent(parent) {
+    : Path(path), PathHash(CRC64(path.c_str())), Owner(owner), Parent(parent) {
     mHash = CalculateHash();
 }
 
 bool ResourceIdentifier::operator==(const ResourceIdentifier& rhs) const {
-    return Owner == rhs.Owner && Path == rhs.Path && Parent == rhs.Parent;
+    // The path comparison only runs once the hashes agree, it guards against CRC64 collisions.
+    return PathHash == rhs.PathHash && Owner == rhs.Owner && Parent == rhs.Parent && Path == rhs.Path;
 }
 
 size_t ResourceIdentifier::CalculateHash() {
-    size_t hash = Math::HashCombine(std::hash<std::string>{}(Path), std::hash<std::uintptr_t>{}(Owner));
+    size_t hash = Math::HashCombine(static_cast<size_t>(PathHash), std::hash<std::uintptr_t>{}(Owner));
     if (Parent != nullptr) {
-        hash = Math::HashCombine(hash, std::hash<std::string>{}(Parent->GetPath()));
+        // Identifiers compare their parent archive by pointer, so hashing the pointer is enough.
+        hash = Math::HashCombine(hash, std::hash<Archive*>{}(Parent.get()));
     }
     return hash;
 }
@@ -137,36 +140,37 @@ std::shared_ptr<IResource> ResourceManager::LoadResourceProcess(const ResourceId
         }
     }
 
-    // Get the file from the OTR
-    auto file = LoadFileProcess(identifier.Path);
+    // Get the file from the OTR, reusing the CRC64 the identifier already carries
+    auto file = identifier.Path.empty() ? nullptr : mArchiveManager->LoadFile(identifier.PathHash);
     if (file == nullptr) {
         SPDLOG_TRACE("Failed to load resource file at path {}", identifier.Path);
-        mResourceCache[identifier] = ResourceLoadError::NotFound;
+        SetCacheLine(identifier, ResourceLoadError::NotFound);
         return nullptr;
     }
 
     // Transform the raw data into a resource
     auto resource = GetResourceLoader()->LoadResource(identifier.Path, file, initData);
+    if (resource != nullptr) {
+        // Not every resource type reports its full size, so the data it was made from is the floor
+        resource->SetMemorySize(std::max(resource->GetPointerSize(), file->GetSize()));
+        resource->SetLoadEpoch(mMemoryEpoch);
+    }
 
     // Another thread could have loaded the resource while we were processing, so we want to check before setting to
     // the cache.
     cachedResource = GetCachedResource(identifier, true);
 
-    {
-        const std::lock_guard<std::mutex> lock(mMutex);
-
-        if (cachedResource != nullptr) {
-            // If another thread has already loaded this resource, discard the work we already did and return from
-            // cache.
-            resource = cachedResource;
-        }
+    if (cachedResource != nullptr) {
+        // If another thread has already loaded this resource, discard the work we already did and return from
+        // cache.
+        resource = cachedResource;
+    }
 
-        // Set the cache to the loaded resource
-        if (resource != nullptr) {
-            mResourceCache[identifier] = resource;
-        } else {
-            mResourceCache[identifier] = ResourceLoadError::NotFound;
-        }
+    // Set the cache to the loaded resource
+    if (resource != nullptr) {
+        SetCacheLine(identifier, resource);
+    } else {
+        SetCacheLine(identifier, ResourceLoadError::NotFound);
     }
 
     if (resource != nullptr) {
@@ -215,6 +219,22 @@ ResourceManager::LoadResourceAsync(const std::string& filePath, bool loadExact,
 
 std::shared_ptr<IResource> ResourceManager::LoadResource(const ResourceIdentifier& identifier, bool loadExact,
                                                          std::shared_ptr<ResourceInitData> initData) {
+    // Check for and remove the OTR signature
+    if (OtrSignatureCheck(identifier.Path.c_str())) {
+        return LoadResource({ identifier.Path.substr(7), identifier.Owner, identifier.Parent }, loadExact, initData);
+    }
+
+    if (mAccessTraceActive.load(std::memory_order_relaxed)) {
+        const std::lock_guard<std::mutex> lock(mAccessTraceMutex);
+        mAccessTrace.insert(identifier.Path);
+    }
+
+    // Cache hits are answered here instead of through a future from LoadResourceAsync
+    auto cachedResource = GetCachedResource(identifier, loadExact);
+    if (cachedResource != nullptr) {
+        return cachedResource;
+    }
+
     auto resource = LoadResourceAsync(identifier, loadExact, BS::pr::highest, initData).get();
     if (resource == nullptr) {
         SPDLOG_TRACE("Failed to load resource file at path {}", identifier.Path);
@@ -240,16 +260,60 @@ ResourceManager::CheckCache(const ResourceIdentifier& identifier, bool loadExact
         }
     }
 
-    const std::lock_guard<std::mutex> lock(mMutex);
+    auto& shard = GetCacheShard(identifier);
+    const std::shared_lock<std::shared_mutex> lock(shard.Mutex);
 
-    auto cacheFind = mResourceCache.find(identifier);
-    if (cacheFind == mResourceCache.end()) {
+    auto cacheFind = shard.Entries.find(identifier);
+    if (cacheFind == shard.Entries.end()) {
         return ResourceLoadError::NotCached;
     }
 
     return cacheFind->second;
 }
 
+ResourceManager::ResourceCacheShard& ResourceManager::GetCacheShard(const ResourceIdentifier& identifier) {
+    // The top bits of the CRC64 are independent of the bucket index the shard's map uses
+    return mResourceCache[identifier.PathHash >> 60];
+}
+
+void ResourceManager::SetCacheLine(const ResourceIdentifier& identifier, ResourceCacheLine cacheLine) {
+    // Released after the lock like in UnloadResource, the destructor can load other resources
+    ResourceCacheLine previous = ResourceLoadError::NotCached;
+    auto& shard = GetCacheShard(identifier);
+
+    {
+        const std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+        auto entry = shard.Entries.try_emplace(identifier, ResourceLoadError::NotCached).first;
+        previous = std::move(entry->second);
+        entry->second = std::move(cacheLine);
+        AccountCacheLine(entry->second, true);
+    }
+
+    AccountCacheLine(previous, false);
+}
+
+void ResourceManager::AccountCacheLine(const ResourceCacheLine& cacheLine, bool resident) {
+    auto resource = std::get_if<std::shared_ptr<IResource>>(&cacheLine);
+    if (resource == nullptr || *resource == nullptr) {
+        return;
+    }
+
+    const size_t bytes = (*resource)->GetMemorySize();
+    const auto initData = (*resource)->GetInitData();
+    const std::lock_guard<std::mutex> lock(mMemoryStatsMutex);
+    auto& stats = mMemoryStats[initData != nullptr ? initData->Type : 0];
+
+    if (resident) {
+        mResidentMemory += bytes;
+        stats.Count++;
+        stats.Bytes += bytes;
+    } else {
+        mResidentMemory -= bytes;
+        stats.Count--;
+        stats.Bytes -= bytes;
+    }
+}
+
 std::variant<ResourceManager::ResourceLoadError, std::shared_ptr<IResource>>
 ResourceManager::CheckCache(const std::string& filePath, bool loadExact) {
     return CheckCache({ filePath, mDefaultCacheOwner, mDefaultCacheArchive }, loadExact);
@@ -280,6 +344,7 @@ ResourceManager::GetCachedResource(std::variant<ResourceLoadError, std::shared_p
                 return nullptr;
             }
 
+            resource->MarkUsed(mMemoryEpoch.load(std::memory_order_relaxed));
             return resource;
         } catch (std::bad_variant_access const& e) {
             // Ignore the exception
@@ -339,6 +404,8 @@ void ResourceManager::DirtyResources(const ResourceFilter& filter) {
                 UnloadResource({ key, filter.Owner, filter.Parent });
             }
         }
+
+        mCacheGeneration++;
     });
 }
 
@@ -382,14 +449,22 @@ size_t ResourceManager::UnloadResource(const ResourceIdentifier& identifier) {
     // Store a shared pointer here so that erase doesn't destruct the resource.
     // The resource will attempt to load other resources on the destructor, and this will fail because we already hold
     // the mutex.
-    std::variant<ResourceLoadError, std::shared_ptr<IResource>> value = nullptr;
+    ResourceCacheLine value = nullptr;
     size_t ret = 0;
-    // We can only erase the resource if we have any resources for that owner.
-    if (mResourceCache.contains(identifier)) {
-        const std::lock_guard<std::mutex> lock(mMutex);
-        mResourceCache.erase(identifier);
+    auto& shard = GetCacheShard(identifier);
+
+    {
+        const std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+        auto cacheFind = shard.Entries.find(identifier);
+        if (cacheFind != shard.Entries.end()) {
+            value = std::move(cacheFind->second);
+            shard.Entries.erase(cacheFind);
+            mCacheGeneration++;
+            ret = 1;
+        }
     }
 
+    AccountCacheLine(value, false);
     return ret;
 }
 
@@ -407,7 +482,201 @@ bool ResourceManager::IsAltAssetsEnabled() {
 }
 
 void ResourceManager::SetAltAssetsEnabled(bool isEnabled) {
+    bool changed = mAltAssetsEnabled != isEnabled;
     mAltAssetsEnabled = isEnabled;
+    if (changed) {
+        mCacheGeneration++;
+    }
+}
+
+uint32_t ResourceManager::GetCacheGeneration() {
+    return mCacheGeneration;
+}
+
+void ResourceManager::StartAccessTrace() {
+    {
+        const std::lock_guard<std::mutex> lock(mAccessTraceMutex);
+        mAccessTrace.clear();
+    }
+    mAccessTraceActive = true;
+    mCacheGeneration++;
+}
+
+std::vector<std::string> ResourceManager::StopAccessTrace() {
+    mAccessTraceActive = false;
+
+    const std::lock_guard<std::mutex> lock(mAccessTraceMutex);
+    std::vector<std::string> paths(mAccessTrace.begin(), mAccessTrace.end());
+    mAccessTrace.clear();
+    return paths;
+}
+
+bool ResourceManager::IsAccessTraceActive() {
+    return mAccessTraceActive;
+}
+
+void ResourceManager::SetMemoryBudget(size_t bytes) {
+    mMemoryBudget = bytes;
+}
+
+size_t ResourceManager::GetMemoryBudget() {
+    return mMemoryBudget;
+}
+
+size_t ResourceManager::GetResidentMemory() {
+    return mResidentMemory;
+}
+
+void ResourceManager::BeginMemoryEpoch() {
+    mMemoryEpoch++;
+    mCacheGeneration++;
+}
+
+uint32_t ResourceManager::GetMemoryEpoch() {
+    return mMemoryEpoch;
+}
+
+void ResourceManager::SetPinnedResources(const std::vector<std::string>& paths) {
+    const std::lock_guard<std::mutex> lock(mPinnedMutex);
+
+    mPinnedResources.clear();
+    for (const auto& path : paths) {
+        mPinnedResources.insert(CRC64(path.c_str()));
+        mPinnedResources.insert(CRC64((IResource::gAltAssetPrefix + path).c_str()));
+    }
+}
+
+void ResourceManager::SetResourceTypePinned(uint32_t type, bool pinned) {
+    const std::lock_guard<std::mutex> lock(mPinnedMutex);
+
+    if (pinned) {
+        mPinnedTypes.insert(type);
+    } else {
+        mPinnedTypes.erase(type);
+    }
+}
+
+std::unordered_map<uint32_t, ResourceMemoryStats> ResourceManager::GetMemoryStats() {
+    const std::lock_guard<std::mutex> lock(mMemoryStatsMutex);
+    return mMemoryStats;
+}
+
+// Expects mPinnedMutex to be held
+bool ResourceManager::IsEvictable(const ResourceIdentifier& identifier, const std::shared_ptr<IResource>& resource) {
+    // Anything outside the cache holding the resource is still using it
+    if (resource == nullptr || resource.use_count() > 1) {
+        return false;
+    }
+
+    if (resource->GetLoadEpoch() == 0 || resource->GetLastUseEpoch() >= mMemoryEpoch) {
+        return false;
+    }
+
+    const auto initData = resource->GetInitData();
+    if (initData != nullptr && mPinnedTypes.contains(initData->Type)) {
+        return false;
+    }
+
+    return !mPinnedResources.contains(identifier.PathHash);
+}
+
+void ResourceManager::SetEvictionCallback(std::function<void(const std::shared_ptr<IResource>&)> callback) {
+    mEvictionCallback = std::move(callback);
+}
+
+size_t ResourceManager::EnforceMemoryBudget() {
+    const size_t budget = mMemoryBudget;
+    const uint32_t epoch = mMemoryEpoch;
+    if (budget == 0 || mResidentMemory <= budget) {
+        return 0;
+    }
+
+    // Nothing could be unloaded last time and nothing has changed since
+    if (mBudgetStalledAt != 0 && mBudgetStalledEpoch == epoch && mResidentMemory <= mBudgetStalledAt) {
+        return 0;
+    }
+
+    struct Candidate {
+        ResourceIdentifier Identifier;
+        uint32_t LastUse;
+    };
+    std::vector<Candidate> candidates;
+    std::vector<std::shared_ptr<IResource>> evicted;
+
+    {
+        const std::lock_guard<std::mutex> pinnedLock(mPinnedMutex);
+
+        for (auto& shard : mResourceCache) {
+            const std::shared_lock<std::shared_mutex> lock(shard.Mutex);
+            for (const auto& [identifier, cacheLine] : shard.Entries) {
+                auto resource = std::get_if<std::shared_ptr<IResource>>(&cacheLine);
+                if (resource != nullptr && IsEvictable(identifier, *resource)) {
+                    candidates.push_back({ identifier, (*resource)->GetLastUseEpoch() });
+                }
+            }
+        }
+
+        // Least recently used first
+        std::vector<size_t> order(candidates.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return candidates[a].LastUse < candidates[b].LastUse; });
+
+        // Unload a little past the budget so the next few loads don't go over it again right away
+        const size_t target = budget - budget / 8;
+        for (size_t index : order) {
+            if (mResidentMemory <= target) {
+                break;
+            }
+
+            const auto& identifier = candidates[index].Identifier;
+            auto& shard = GetCacheShard(identifier);
+            const std::unique_lock<std::shared_mutex> lock(shard.Mutex);
+
+            // The resource can have been handed out again since the candidates were collected
+            auto cacheFind = shard.Entries.find(identifier);
+            if (cacheFind == shard.Entries.end()) {
+                continue;
+            }
+            auto resource = std::get_if<std::shared_ptr<IResource>>(&cacheFind->second);
+            if (resource == nullptr || !IsEvictable(identifier, *resource)) {
+                continue;
+            }
+
+            AccountCacheLine(cacheFind->second, false);
+            {
+                const auto initData = (*resource)->GetInitData();
+                const std::lock_guard<std::mutex> statsLock(mMemoryStatsMutex);
+                mMemoryStats[initData != nullptr ? initData->Type : 0].Evictions++;
+            }
+            evicted.push_back(std::move(*resource));
+            shard.Entries.erase(cacheFind);
+        }
+    }
+
+    if (mResidentMemory > budget) {
+        mBudgetStalledAt = mResidentMemory;
+        mBudgetStalledEpoch = epoch;
+    } else {
+        mBudgetStalledAt = 0;
+    }
+
+    const size_t count = evicted.size();
+    if (count > 0) {
+        if (mEvictionCallback) {
+            for (const auto& resource : evicted) {
+                mEvictionCallback(resource);
+            }
+        }
+        mCacheGeneration++;
+        SPDLOG_INFO("Unloaded {} resources to stay within the {} MB resource budget", count, budget / (1024 * 1024));
+    }
+
+    // Unloaded without any cache lock held, a resource releasing its dependencies can unload more
+    evicted.clear();
+    return count;
 }
 
 } // namespace Ship
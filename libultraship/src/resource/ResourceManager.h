@@ -6,8 +6,12 @@
 #include <list>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <array>
+#include <atomic>
 #include <queue>
 #include <variant>
+#include <functional>
 #include "resource/Resource.h"
 #include "resource/ResourceLoader.h"
 #include "resource/archive/Archive.h"
@@ -38,6 +42,8 @@ struct ResourceIdentifier {
 
     // Must be an exact path. Passing a path with a wildcard will return a fail state
     const std::string Path = "";
+    // CRC64 of Path, the same key the archives index their files with
+    const uint64_t PathHash = 0;
     const uintptr_t Owner = 0;
     const std::shared_ptr<Archive> Parent = nullptr;
 
@@ -51,6 +57,12 @@ struct ResourceIdentifierHash {
     size_t operator()(const ResourceIdentifier& rcd) const;
 };
 
+struct ResourceMemoryStats {
+    size_t Count = 0;
+    size_t Bytes = 0;
+    size_t Evictions = 0;
+};
+
 class ResourceManager {
     friend class ResourceLoader;
     typedef enum class ResourceLoadError { None, NotCached, NotFound } ResourceLoadError;
@@ -102,9 +114,38 @@ class ResourceManager {
     bool OtrSignatureCheck(const char* fileName);
     bool IsAltAssetsEnabled();
     void SetAltAssetsEnabled(bool isEnabled);
+    // Changes whenever a cached resource may have been unloaded, dirtied or swapped for its alternate version.
+    // Callers that keep raw pointers into resources must resolve them again when it moves.
+    uint32_t GetCacheGeneration();
+    // Records the path of every resource requested through LoadResource, cached or not, until the trace is
+    // stopped. Starting a trace moves the cache generation so pointer caches resolve through LoadResource again.
+    void StartAccessTrace();
+    std::vector<std::string> StopAccessTrace();
+    bool IsAccessTraceActive();
     std::shared_ptr<File> LoadFileProcess(const ResourceIdentifier& identifier);
     std::shared_ptr<File> LoadFileProcess(const std::string& filePath);
 
+    // Memory budget for cached resources, 0 for none. When the cache is over it, EnforceMemoryBudget unloads
+    // resources that nothing outside the cache holds, least recently used first. Only resources that weren't used
+    // in the current memory epoch are candidates, and resources loaded before the first epoch never are, since the
+    // game keeps raw pointers to those around. Unloading moves the cache generation.
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget();
+    size_t GetResidentMemory();
+    size_t EnforceMemoryBudget();
+    // Called with each resource EnforceMemoryBudget unloads, on the thread enforcing the budget and before the
+    // resource is released, so caches keyed by its address can drop it
+    void SetEvictionCallback(std::function<void(const std::shared_ptr<IResource>&)> callback);
+    // Starts a new memory epoch, e.g. when a level is entered. Moves the cache generation so pointer caches resolve
+    // through LoadResource again and mark what the new epoch uses.
+    void BeginMemoryEpoch();
+    uint32_t GetMemoryEpoch();
+    // Pinned resources and resource types are never unloaded by the budget
+    void SetPinnedResources(const std::vector<std::string>& paths);
+    void SetResourceTypePinned(uint32_t type, bool pinned);
+    // Resident resources, their bytes and budget evictions by resource type
+    std::unordered_map<uint32_t, ResourceMemoryStats> GetMemoryStats();
+
   protected:
     std::shared_ptr<std::vector<std::shared_ptr<IResource>>> LoadResourcesProcess(const ResourceFilter& filter);
     void UnloadResourcesProcess(const ResourceFilter& filter);
@@ -116,14 +157,43 @@ class ResourceManager {
     std::shared_ptr<IResource> GetCachedResource(std::variant<ResourceLoadError, std::shared_ptr<IResource>> cacheLine);
 
   private:
-    std::unordered_map<ResourceIdentifier, std::variant<ResourceLoadError, std::shared_ptr<IResource>>,
-                       ResourceIdentifierHash>
-        mResourceCache;
+    typedef std::variant<ResourceLoadError, std::shared_ptr<IResource>> ResourceCacheLine;
+
+    struct ResourceCacheShard {
+        std::shared_mutex Mutex;
+        std::unordered_map<ResourceIdentifier, ResourceCacheLine, ResourceIdentifierHash> Entries;
+    };
+
+    ResourceCacheShard& GetCacheShard(const ResourceIdentifier& identifier);
+    void SetCacheLine(const ResourceIdentifier& identifier, ResourceCacheLine cacheLine);
+    void AccountCacheLine(const ResourceCacheLine& cacheLine, bool resident);
+    bool IsEvictable(const ResourceIdentifier& identifier, const std::shared_ptr<IResource>& resource);
+
+    // Cache hits only take a shared lock on one shard, so the game, audio and loader threads don't queue
+    // up behind each other on a single mutex.
+    static constexpr size_t RESOURCE_CACHE_SHARD_COUNT = 16;
+    std::array<ResourceCacheShard, RESOURCE_CACHE_SHARD_COUNT> mResourceCache;
     std::shared_ptr<ResourceLoader> mResourceLoader;
     std::shared_ptr<ArchiveManager> mArchiveManager;
     std::shared_ptr<BS::thread_pool> mThreadPool;
-    std::mutex mMutex;
     bool mAltAssetsEnabled = false;
+    std::atomic<uint32_t> mCacheGeneration = 0;
+    std::atomic<bool> mAccessTraceActive = false;
+    std::mutex mAccessTraceMutex;
+    std::unordered_set<std::string> mAccessTrace;
+    std::atomic<size_t> mMemoryBudget = 0;
+    std::atomic<size_t> mResidentMemory = 0;
+    std::atomic<uint32_t> mMemoryEpoch = 0;
+    // Resident memory after the last EnforceMemoryBudget that couldn't get under the budget, so it isn't retried
+    // every frame until something changed
+    size_t mBudgetStalledAt = 0;
+    uint32_t mBudgetStalledEpoch = 0;
+    std::function<void(const std::shared_ptr<IResource>&)> mEvictionCallback;
+    std::mutex mMemoryStatsMutex;
+    std::unordered_map<uint32_t, ResourceMemoryStats> mMemoryStats;
+    std::mutex mPinnedMutex;
+    std::unordered_set<uint64_t> mPinnedResources;
+    std::unordered_set<uint32_t> mPinnedTypes;
     // Private information for which owner and archive are default.
     uintptr_t mDefaultCacheOwner = 0;
     std::shared_ptr<Archive> mDefaultCacheArchive = nullptr;
@@ -34,7 +34,7 @@ void Archive::Load() {
     bool isGameVersionValid = false;
     if (t != nullptr && t->IsLoaded) {
         mHasGameVersion = true;
-        auto stream = std::make_shared<MemoryStream>(t->Buffer->data(), t->Buffer->size());
+        auto stream = std::make_shared<MemoryStream>(t->GetData(), t->GetSize());
         auto reader = std::make_shared<BinaryReader>(stream);
         Endianness endianness = (Endianness)reader->ReadUByte();
         reader->SetEndianness(endianness);
@@ -0,0 +1,96 @@
+#include "ArchiveCompression.h"
+
+#include <cstring>
+
+#include "zip.h"
+#include "spdlog/spdlog.h"
+
+namespace Ship {
+static zip_int32_t GetZipCompressionMethod(ArchiveCompression compression) {
+    switch (compression) {
+        case ArchiveCompression::Store:
+            return ZIP_CM_STORE;
+#ifdef ZIP_CM_ZSTD
+        case ArchiveCompression::Zstd:
+            return ZIP_CM_ZSTD;
+#endif
+        case ArchiveCompression::Deflate:
+        default:
+            return ZIP_CM_DEFLATE;
+    }
+}
+
+bool IsArchiveCompressionSupported(ArchiveCompression compression) {
+#ifndef ZIP_CM_ZSTD
+    // libzip before 1.8 has no zstd method at all
+    if (compression == ArchiveCompression::Zstd) {
+        return false;
+    }
+#endif
+    zip_int32_t method = GetZipCompressionMethod(compression);
+    return zip_compression_method_supported(method, 1) && zip_compression_method_supported(method, 0);
+}
+
+const char* GetArchiveCompressionName(ArchiveCompression compression) {
+    switch (compression) {
+        case ArchiveCompression::Store:
+            return "store";
+        case ArchiveCompression::Zstd:
+            return "zstd";
+        case ArchiveCompression::Deflate:
+        default:
+            return "deflate";
+    }
+}
+
+static void OnRecompressProgress(zip_t* archive, double fraction, void* userData) {
+    (*static_cast<const std::function<void(double)>*>(userData))(fraction);
+}
+
+bool RecompressArchive(const std::string& path, ArchiveCompression compression, uint32_t level,
+                       const std::function<void(double)>& progress) {
+    if (!IsArchiveCompressionSupported(compression)) {
+        SPDLOG_ERROR("Cannot recompress \"{}\": {} is not supported by this build of libzip", path,
+                     GetArchiveCompressionName(compression));
+        return false;
+    }
+
+    int error = 0;
+    zip_t* archive = zip_open(path.c_str(), 0, &error);
+    if (archive == nullptr) {
+        SPDLOG_ERROR("Failed to open zip file \"{}\" for recompression", path);
+        return false;
+    }
+
+    zip_int32_t method = GetZipCompressionMethod(compression);
+    zip_int64_t numEntries = zip_get_num_entries(archive, 0);
+    for (zip_int64_t i = 0; i < numEntries; i++) {
+        const char* name = zip_get_name(archive, i, 0);
+        if (name == nullptr || name[0] == '\0' || name[strlen(name) - 1] == '/') {
+            continue;
+        }
+
+        // libzip decodes and re-encodes the entry with the new method when the archive is closed
+        if (zip_set_file_compression(archive, i, method, level) != 0) {
+            SPDLOG_ERROR("Failed to set compression of \"{}\" in \"{}\": {}", name, path,
+                         zip_strerror(archive));
+            zip_discard(archive);
+            return false;
+        }
+    }
+
+    if (progress) {
+        zip_register_progress_callback_with_state(archive, 0.01, OnRecompressProgress, nullptr,
+                                                  const_cast<std::function<void(double)>*>(&progress));
+    }
+
+    if (zip_close(archive) != 0) {
+        SPDLOG_ERROR("Failed to write recompressed zip file \"{}\": {}", path, zip_strerror(archive));
+        zip_discard(archive);
+        return false;
+    }
+
+    SPDLOG_INFO("Recompressed {} entries of {} with {}", numEntries, path, GetArchiveCompressionName(compression));
+    return true;
+}
+} // namespace Ship
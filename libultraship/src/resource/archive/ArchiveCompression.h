@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+namespace Ship {
+enum class ArchiveCompression { Store, Deflate, Zstd };
+
+// Whether the libzip in use can read and write entries compressed this way. Zstd (zip method 93) needs
+// libzip 1.8 or newer built with zstd support.
+bool IsArchiveCompressionSupported(ArchiveCompression compression);
+
+// Rewrites every entry of the zip archive at path with the given compression. Level 0 is the method's default.
+// The archive must not be open anywhere else while it is rewritten. progress is called with the fraction written
+// so far while the entries are re-encoded.
+bool RecompressArchive(const std::string& path, ArchiveCompression compression, uint32_t level = 0,
+                       const std::function<void(double)>& progress = nullptr);
+
+const char* GetArchiveCompressionName(ArchiveCompression compression);
+} // namespace Ship
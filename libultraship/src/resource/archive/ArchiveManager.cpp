@@ -1,6 +1,9 @@
 #include "ArchiveManager.h"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <thread>
 #include "spdlog/spdlog.h"
 
 #include "resource/archive/Archive.h"
@@ -9,6 +12,7 @@
 #endif
 #include "resource/archive/O2rArchive.h"
 #include "resource/archive/FolderArchive.h"
+#include "resource/archive/MappedArchive.h"
 #include "utils/StringHelper.h"
 #include "utils/glob.h"
 #include "utils/StrHash64.h"
@@ -24,7 +28,31 @@ void ArchiveManager::Init(const std::vector<std::string>& archivePaths) {
 void ArchiveManager::Init(const std::vector<std::string>& archivePaths,
                           const std::unordered_set<uint32_t>& validGameVersions) {
     mValidGameVersions = validGameVersions;
-    auto archives = GetArchiveListInPaths(archivePaths);
+    auto archivePathList = GetArchiveListInPaths(archivePaths);
+
+    // Opening reads and indexes each archive, which is independent of the others, so it is spread over
+    // threads. They are added in the original order afterwards since later archives override earlier ones.
+    std::vector<std::shared_ptr<Archive>> archives(archivePathList.size());
+    std::atomic<size_t> nextArchive = 0;
+    auto openArchives = [&]() {
+        for (size_t i = nextArchive++; i < archivePathList.size(); i = nextArchive++) {
+            SPDLOG_INFO("Reading archive: {}", archivePathList[i]);
+            archives[i] = CreateArchive(archivePathList[i]);
+            archives[i]->Load();
+        }
+    };
+
+    const size_t threadCount =
+        std::min<size_t>(archivePathList.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(openArchives);
+    }
+    openArchives();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
     for (const auto& archive : archives) {
         AddArchive(archive);
     }
@@ -207,7 +235,8 @@ std::vector<std::string> ArchiveManager::GetArchiveListInPaths(const std::vector
                     if (StringHelper::IEquals(p.path().extension().string(), ".otr") ||
                         StringHelper::IEquals(p.path().extension().string(), ".zip") ||
                         StringHelper::IEquals(p.path().extension().string(), ".mpq") ||
-                        StringHelper::IEquals(p.path().extension().string(), ".o2r")) {
+                        StringHelper::IEquals(p.path().extension().string(), ".o2r") ||
+                        StringHelper::IEquals(p.path().extension().string(), ".o2m")) {
                         fileList.push_back(std::filesystem::absolute(p).string());
                     }
                 }
@@ -224,15 +253,15 @@ std::vector<std::string> ArchiveManager::GetArchiveListInPaths(const std::vector
     return fileList;
 }
 
-std::shared_ptr<Archive> ArchiveManager::AddArchive(const std::string& archivePath) {
+std::shared_ptr<Archive> ArchiveManager::CreateArchive(const std::string& archivePath) {
     const std::filesystem::path path = archivePath;
     const std::string extension = path.extension().string();
     std::shared_ptr<Archive> archive = nullptr;
 
-    SPDLOG_INFO("Reading archive: {}", path.string());
-
     if (StringHelper::IEquals(extension, ".o2r") || StringHelper::IEquals(extension, ".zip")) {
         archive = dynamic_pointer_cast<Archive>(std::make_shared<O2rArchive>(archivePath));
+    } else if (StringHelper::IEquals(extension, ".o2m")) {
+        archive = dynamic_pointer_cast<Archive>(std::make_shared<MappedArchive>(archivePath));
 #ifndef EXCLUDE_MPQ_SUPPORT
     } else if (StringHelper::IEquals(extension, ".otr") || StringHelper::IEquals(extension, ".mpq")) {
         archive = dynamic_pointer_cast<Archive>(std::make_shared<OtrArchive>(archivePath));
@@ -245,6 +274,13 @@ std::shared_ptr<Archive> ArchiveManager::AddArchive(const std::string& archivePa
         archive = std::make_shared<O2rArchive>(archivePath);
     }
 
+    return archive;
+}
+
+std::shared_ptr<Archive> ArchiveManager::AddArchive(const std::string& archivePath) {
+    SPDLOG_INFO("Reading archive: {}", std::filesystem::path(archivePath).string());
+
+    auto archive = CreateArchive(archivePath);
     archive->Load();
     return AddArchive(archive);
 }
@@ -20,6 +20,8 @@ class ArchiveManager {
     void Init(const std::vector<std::string>& archivePaths, const std::unordered_set<uint32_t>& validGameVersions);
     ~ArchiveManager();
 
+    // Creates the archive type matching the path's extension, without opening or adding it
+    static std::shared_ptr<Archive> CreateArchive(const std::string& archivePath);
     std::shared_ptr<Archive> AddArchive(const std::string& archivePath);
     std::shared_ptr<Archive> AddArchive(std::shared_ptr<Archive> archive);
     std::shared_ptr<std::vector<std::shared_ptr<Archive>>> GetArchives();
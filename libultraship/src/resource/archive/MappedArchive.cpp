@@ -0,0 +1,331 @@
+#include "MappedArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "spdlog/spdlog.h"
+#include "utils/StrHash64.h"
+#include "utils/binarytools/endianness.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__SWITCH__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Ship {
+static const char sMappedArchiveMagic[8] = { 'S', 'H', 'I', 'P', 'O', '2', 'M', '\0' };
+
+static std::shared_ptr<char> MapArchiveFile(const std::string& path, size_t* size) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    // The view keeps the mapping object alive on its own
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    *size = static_cast<size_t>(fileSize.QuadPart);
+    return std::shared_ptr<char>(static_cast<char*>(data), [](char* data) { UnmapViewOfFile(data); });
+#elif defined(__SWITCH__)
+    // No file mappings, read the whole archive once instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open() || file.tellg() <= 0) {
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(file.tellg());
+    std::shared_ptr<char> data(new char[length], std::default_delete<char[]>());
+    file.seekg(0);
+    if (!file.read(data.get(), length)) {
+        return nullptr;
+    }
+
+    *size = length;
+    return data;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(fileStat.st_size);
+    void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    *size = length;
+    return std::shared_ptr<char>(static_cast<char*>(data), [length](char* data) { munmap(data, length); });
+#endif
+}
+
+MappedArchive::MappedArchive(const std::string& archivePath) : Archive(archivePath) {
+}
+
+MappedArchive::~MappedArchive() {
+    SPDLOG_TRACE("destruct mappedarchive: {}", GetPath());
+    if (mMapping != nullptr) {
+        Close();
+    }
+}
+
+const MappedArchiveEntry* MappedArchive::FindEntry(uint64_t hash) const {
+    const MappedArchiveEntry* end = mEntries + mEntryCount;
+    const MappedArchiveEntry* entry = std::lower_bound(
+        mEntries, end, hash, [](const MappedArchiveEntry& entry, uint64_t hash) { return entry.Hash < hash; });
+
+    return (entry != end && entry->Hash == hash) ? entry : nullptr;
+}
+
+std::shared_ptr<File> MappedArchive::LoadFile(uint64_t hash) {
+    const std::shared_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    if (mMapping == nullptr) {
+        SPDLOG_TRACE("Failed to open file {:016X} from mapped archive {}. Archive not open.", hash, GetPath());
+        return nullptr;
+    }
+
+    const MappedArchiveEntry* entry = FindEntry(hash);
+    if (entry == nullptr) {
+        SPDLOG_TRACE("Failed to find file {:016X} in mapped archive {}.", hash, GetPath());
+        return nullptr;
+    }
+
+    // Filesize 0, no logging needed
+    if (entry->Size == 0) {
+        return nullptr;
+    }
+
+    auto fileToLoad = std::make_shared<File>();
+    fileToLoad->Storage = mMapping;
+    fileToLoad->Data = mMapping.get() + entry->Offset;
+    fileToLoad->Size = entry->Size;
+    fileToLoad->IsLoaded = true;
+
+    return fileToLoad;
+}
+
+std::shared_ptr<File> MappedArchive::LoadFile(const std::string& filePath) {
+    return LoadFile(CRC64(filePath.c_str()));
+}
+
+bool MappedArchive::Open() {
+    const std::unique_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    size_t size = 0;
+    std::shared_ptr<char> mapping = MapArchiveFile(GetPath(), &size);
+    if (mapping == nullptr) {
+        SPDLOG_ERROR("Failed to map archive \"{}\"", GetPath());
+        return false;
+    }
+
+    MappedArchiveHeader header;
+    if (size < sizeof(header)) {
+        SPDLOG_ERROR("Failed to load mapped archive \"{}\". File too small.", GetPath());
+        return false;
+    }
+    memcpy(&header, mapping.get(), sizeof(header));
+
+    if (memcmp(header.Magic, sMappedArchiveMagic, sizeof(sMappedArchiveMagic)) == 0 &&
+        BSWAP32(header.Version) == MAPPED_ARCHIVE_VERSION) {
+        SPDLOG_ERROR("Failed to load mapped archive \"{}\". It was written on a machine with the other byte order, "
+                     "convert the archive again on this one.",
+                     GetPath());
+        return false;
+    }
+
+    if (memcmp(header.Magic, sMappedArchiveMagic, sizeof(sMappedArchiveMagic)) != 0 ||
+        header.Version != MAPPED_ARCHIVE_VERSION) {
+        SPDLOG_ERROR("Failed to load mapped archive \"{}\". Unknown format or version.", GetPath());
+        return false;
+    }
+
+    if (header.FileSize != size || header.EntriesOffset % alignof(MappedArchiveEntry) != 0 ||
+        header.EntriesOffset > size || header.EntryCount > (size - header.EntriesOffset) / sizeof(MappedArchiveEntry) ||
+        header.NamesOffset > size || header.NamesSize > size - header.NamesOffset) {
+        SPDLOG_ERROR("Failed to load mapped archive \"{}\". The file is truncated or corrupt.", GetPath());
+        return false;
+    }
+
+    auto entries = reinterpret_cast<const MappedArchiveEntry*>(mapping.get() + header.EntriesOffset);
+    const char* names = mapping.get() + header.NamesOffset;
+    for (uint32_t i = 0; i < header.EntryCount; i++) {
+        const MappedArchiveEntry& entry = entries[i];
+        if (entry.Offset > size || entry.Size > size - entry.Offset || entry.NameOffset > header.NamesSize ||
+            entry.NameLength > header.NamesSize - entry.NameOffset || (i > 0 && entries[i - 1].Hash >= entry.Hash)) {
+            SPDLOG_ERROR("Failed to load mapped archive \"{}\". Entry {} is corrupt.", GetPath(), i);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < header.EntryCount; i++) {
+        IndexFile(std::string(names + entries[i].NameOffset, entries[i].NameLength));
+    }
+
+    mMapping = mapping;
+    mMappingSize = size;
+    mEntries = entries;
+    mEntryCount = header.EntryCount;
+
+    return true;
+}
+
+bool MappedArchive::Close() {
+    const std::unique_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    if (mMapping == nullptr) {
+        SPDLOG_ERROR("Cannot close mapped archive. Archive not loaded. \"{}\"", GetPath());
+        return false;
+    }
+
+    // Files and resources still pointing into the mapping keep it alive until they are released
+    mMapping = nullptr;
+    mMappingSize = 0;
+    mEntries = nullptr;
+    mEntryCount = 0;
+
+    return true;
+}
+
+bool MappedArchive::WriteFile(const std::string& filename, const std::vector<uint8_t>& data) {
+    SPDLOG_ERROR("Cannot write \"{}\" to mapped archive \"{}\": mapped archives are read-only.", filename, GetPath());
+    return false;
+}
+
+static void PadStream(std::ofstream& stream, uint64_t alignment) {
+    static const char zeros[MAPPED_ARCHIVE_PAGE_SIZE] = {};
+    uint64_t position = static_cast<uint64_t>(stream.tellp());
+    uint64_t padding = (alignment - position % alignment) % alignment;
+
+    stream.write(zeros, padding);
+}
+
+bool MappedArchive::Convert(std::shared_ptr<Archive> source, const std::string& outputPath) {
+    if (source == nullptr || !source->IsLoaded()) {
+        SPDLOG_ERROR("Cannot convert archive to \"{}\": source archive is not loaded.", outputPath);
+        return false;
+    }
+
+    const std::string temporaryPath = outputPath + ".tmp";
+    std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        SPDLOG_ERROR("Failed to create mapped archive \"{}\"", temporaryPath);
+        return false;
+    }
+
+    // The header is written last, once the table offsets are known
+    MappedArchiveHeader header = {};
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    PadStream(stream, MAPPED_ARCHIVE_PAGE_SIZE);
+
+    std::vector<MappedArchiveEntry> entries;
+    std::string names;
+
+    // The file list only has resource paths, their .meta files have to be asked for by name
+    std::vector<std::string> paths;
+    for (const auto& [hash, path] : *source->ListFiles()) {
+        paths.push_back(path);
+        paths.push_back(path + ".meta");
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto& path : paths) {
+        auto file = source->LoadFile(path);
+        if (file == nullptr || !file->IsLoaded) {
+            continue;
+        }
+
+        uint64_t size = file->GetSize();
+        PadStream(stream, size >= MAPPED_ARCHIVE_PAGE_SIZE ? MAPPED_ARCHIVE_PAGE_SIZE : MAPPED_ARCHIVE_ENTRY_ALIGNMENT);
+
+        MappedArchiveEntry entry = {};
+        entry.Hash = CRC64(path.c_str());
+        entry.Offset = static_cast<uint64_t>(stream.tellp());
+        entry.Size = size;
+        entry.NameOffset = static_cast<uint32_t>(names.size());
+        entry.NameLength = static_cast<uint32_t>(path.size());
+        entries.push_back(entry);
+        names += path;
+
+        stream.write(file->GetData(), size);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const MappedArchiveEntry& a, const MappedArchiveEntry& b) { return a.Hash < b.Hash; });
+    auto duplicate = std::adjacent_find(entries.begin(), entries.end(),
+                                        [](const MappedArchiveEntry& a, const MappedArchiveEntry& b) {
+                                            return a.Hash == b.Hash;
+                                        });
+    if (duplicate != entries.end()) {
+        SPDLOG_ERROR("Cannot convert archive \"{}\": two files share the hash {:016X}.", source->GetPath(),
+                     duplicate->Hash);
+        stream.close();
+        std::filesystem::remove(temporaryPath);
+        return false;
+    }
+
+    PadStream(stream, alignof(MappedArchiveEntry));
+    memcpy(header.Magic, sMappedArchiveMagic, sizeof(sMappedArchiveMagic));
+    header.Version = MAPPED_ARCHIVE_VERSION;
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+    header.EntriesOffset = static_cast<uint64_t>(stream.tellp());
+    stream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(MappedArchiveEntry));
+    header.NamesOffset = static_cast<uint64_t>(stream.tellp());
+    header.NamesSize = names.size();
+    stream.write(names.data(), names.size());
+    header.FileSize = static_cast<uint64_t>(stream.tellp());
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.close();
+
+    if (stream.fail()) {
+        SPDLOG_ERROR("Failed to write mapped archive \"{}\"", temporaryPath);
+        std::filesystem::remove(temporaryPath);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, outputPath, error);
+    if (error) {
+        SPDLOG_ERROR("Failed to move mapped archive to \"{}\": {}", outputPath, error.message());
+        std::filesystem::remove(temporaryPath);
+        return false;
+    }
+
+    SPDLOG_INFO("Converted {} ({} files) to mapped archive {}", source->GetPath(), entries.size(), outputPath);
+    return true;
+}
+
+} // namespace Ship
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "resource/File.h"
+#include "resource/archive/Archive.h"
+
+namespace Ship {
+struct File;
+
+#define MAPPED_ARCHIVE_VERSION 1
+// Offset alignment of each entry, entries of at least a page start on a page boundary
+#define MAPPED_ARCHIVE_ENTRY_ALIGNMENT 16
+#define MAPPED_ARCHIVE_PAGE_SIZE 4096
+
+/*
+ * Uncompressed archive that is memory-mapped instead of read (.o2m).
+ *
+ * Layout, in the byte order of the machine that wrote it, since the index is used in place:
+ *   MappedArchiveHeader, padded to a page
+ *   entry data
+ *   MappedArchiveEntry[EntryCount], sorted by Hash
+ *   entry names, not null terminated
+ *
+ * Files loaded from it are views into the mapping, so loading costs a lookup and the data is paged in
+ * on first use. The mapping is private and writable: resources that are modified in place get their
+ * own copy of the touched pages and the file on disk is never changed. An archive written on a machine
+ * with the other byte order is rejected and has to be converted again.
+ */
+struct MappedArchiveHeader {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t EntryCount;
+    uint64_t EntriesOffset;
+    uint64_t NamesOffset;
+    uint64_t NamesSize;
+    uint64_t FileSize;
+};
+
+struct MappedArchiveEntry {
+    uint64_t Hash;
+    uint64_t Offset;
+    uint64_t Size;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+};
+
+class MappedArchive final : virtual public Archive {
+  public:
+    MappedArchive(const std::string& archivePath);
+    ~MappedArchive();
+
+    bool Open();
+    bool Close();
+    bool WriteFile(const std::string& filename, const std::vector<uint8_t>& data);
+
+    std::shared_ptr<File> LoadFile(const std::string& filePath);
+    std::shared_ptr<File> LoadFile(uint64_t hash);
+
+    // Writes every file of an open archive, including the .meta files next to resources, to a new
+    // mapped archive at outputPath. The archive is written to a temporary file and renamed when done.
+    static bool Convert(std::shared_ptr<Archive> source, const std::string& outputPath);
+
+  private:
+    const MappedArchiveEntry* FindEntry(uint64_t hash) const;
+
+    // The mapping is shared with every file and resource that points into it, so closing the archive
+    // doesn't pull memory out from under loaded resources
+    std::shared_ptr<char> mMapping;
+    size_t mMappingSize = 0;
+    const MappedArchiveEntry* mEntries = nullptr;
+    uint32_t mEntryCount = 0;
+    std::shared_mutex mArchiveMutex;
+};
+} // namespace Ship
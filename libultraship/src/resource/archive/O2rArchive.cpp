@@ -3,8 +3,56 @@
 #include "Context.h"
 #include "window/Window.h"
 #include "spdlog/spdlog.h"
+#include "utils/StrHash64.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 
 namespace Ship {
+/*
+ * Entry index cache (<archive>.idx).
+ *
+ * Indexing an archive walks every zip entry for its name and hashes it, which adds up with large mod
+ * collections. The result is written next to the archive and read back in one go on the next start:
+ *   O2rIndexHeader
+ *   O2rIndexEntry[EntryCount], sorted by Hash
+ *   entry names, not null terminated
+ *
+ * The cache is only used while the archive's size, modification time and the checksum of its tail, which
+ * holds the zip central directory, still match the ones it was written for. It is a local cache in native
+ * byte order, not something to ship.
+ */
+#define O2R_INDEX_VERSION 1
+// The end of central directory record and usually all of the central directory
+#define O2R_INDEX_TAIL_SIZE ((size_t)64 * 1024)
+
+struct O2rArchive::IndexStamp {
+    uint64_t ArchiveSize;
+    int64_t ArchiveTime;
+    uint64_t TailChecksum;
+};
+
+struct O2rIndexHeader {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t EntryCount;
+    uint64_t ArchiveSize;
+    int64_t ArchiveTime;
+    uint64_t TailChecksum;
+    uint64_t NamesSize;
+};
+
+struct O2rIndexEntry {
+    uint64_t Hash;
+    uint64_t ZipIndex;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+};
+
+static const char sIndexMagic[8] = "SHIPIDX";
+
 O2rArchive::O2rArchive(const std::string& archivePath) : Archive(archivePath) {
 }
 
@@ -14,39 +62,46 @@ O2rArchive::~O2rArchive() {
 }
 
 std::shared_ptr<File> O2rArchive::LoadFile(uint64_t hash) {
-    const std::string& filePath =
-        *Context::GetInstance()->GetResourceManager()->GetArchiveManager()->HashToString(hash);
-    return LoadFile(filePath);
-}
+    const std::shared_lock<std::shared_mutex> lock(mArchiveMutex);
 
-std::shared_ptr<File> O2rArchive::LoadFile(const std::string& filePath) {
-    if (mZipArchive == nullptr) {
-        SPDLOG_TRACE("Failed to open file {} from zip archive {}. Archive not open.", filePath, GetPath());
+    if (!mIsOpen) {
+        SPDLOG_TRACE("Failed to open file {:016X} from zip archive {}. Archive not open.", hash, GetPath());
+        return nullptr;
+    }
+
+    auto entry = mEntries.find(hash);
+    if (entry == mEntries.end()) {
+        SPDLOG_TRACE("Failed to find file {:016X} in zip archive  {}.", hash, GetPath());
         return nullptr;
     }
 
-    auto zipEntryIndex = zip_name_locate(mZipArchive, filePath.c_str(), 0);
-    if (zipEntryIndex < 0) {
-        SPDLOG_TRACE("Failed to find file {} in zip archive  {}.", filePath, GetPath());
+    zip_t* zipArchive = AcquireReader();
+    if (zipArchive == nullptr) {
         return nullptr;
     }
 
+    auto file = LoadEntry(zipArchive, entry->second);
+    ReleaseReader(zipArchive);
+    return file;
+}
+
+std::shared_ptr<File> O2rArchive::LoadEntry(zip_t* zipArchive, zip_uint64_t zipEntryIndex) {
     struct zip_stat zipEntryStat;
     zip_stat_init(&zipEntryStat);
-    if (zip_stat_index(mZipArchive, zipEntryIndex, 0, &zipEntryStat) != 0) {
-        SPDLOG_TRACE("Failed to get entry information for file {} in zip archive  {}.", filePath, GetPath());
+    if (zip_stat_index(zipArchive, zipEntryIndex, 0, &zipEntryStat) != 0) {
+        SPDLOG_TRACE("Failed to get entry information for entry {} in zip archive  {}.", zipEntryIndex, GetPath());
         return nullptr;
     }
 
     // Filesize 0, no logging needed
     if (zipEntryStat.size == 0) {
-        SPDLOG_TRACE("Failed to load file {}; filesize 0", filePath, GetPath());
+        SPDLOG_TRACE("Failed to load file {}; filesize 0", zipEntryStat.name, GetPath());
         return nullptr;
     }
 
-    struct zip_file* zipEntryFile = zip_fopen_index(mZipArchive, zipEntryIndex, 0);
+    struct zip_file* zipEntryFile = zip_fopen_index(zipArchive, zipEntryIndex, 0);
     if (!zipEntryFile) {
-        SPDLOG_TRACE("Failed to open file {} in zip archive  {}.", filePath, GetPath());
+        SPDLOG_TRACE("Failed to open file {} in zip archive  {}.", zipEntryStat.name, GetPath());
         return nullptr;
     }
 
@@ -54,11 +109,11 @@ std::shared_ptr<File> O2rArchive::LoadFile(const std::string& filePath) {
     fileToLoad->Buffer = std::make_shared<std::vector<char>>(zipEntryStat.size);
 
     if (zip_fread(zipEntryFile, fileToLoad->Buffer->data(), zipEntryStat.size) < 0) {
-        SPDLOG_TRACE("Error reading file {} in zip archive  {}.", filePath, GetPath());
+        SPDLOG_TRACE("Error reading file {} in zip archive  {}.", zipEntryStat.name, GetPath());
     }
 
     if (zip_fclose(zipEntryFile) != 0) {
-        SPDLOG_TRACE("Error closing file {} in zip archive  {}.", filePath, GetPath());
+        SPDLOG_TRACE("Error closing file {} in zip archive  {}.", zipEntryStat.name, GetPath());
     }
 
     fileToLoad->IsLoaded = true;
@@ -66,15 +121,47 @@ std::shared_ptr<File> O2rArchive::LoadFile(const std::string& filePath) {
     return fileToLoad;
 }
 
-bool O2rArchive::Open() {
-    mZipArchive = zip_open(GetPath().c_str(), ZIP_CREATE, nullptr);
-    if (mZipArchive == nullptr) {
-        SPDLOG_ERROR("Failed to load zip file \"{}\"", GetPath());
-        return false;
+std::shared_ptr<File> O2rArchive::LoadFile(const std::string& filePath) {
+    return LoadFile(CRC64(filePath.c_str()));
+}
+
+zip_t* O2rArchive::AcquireReader() {
+    {
+        const std::lock_guard<std::mutex> lock(mReadersMutex);
+        if (!mIdleReaders.empty()) {
+            zip_t* reader = mIdleReaders.back();
+            mIdleReaders.pop_back();
+            return reader;
+        }
+    }
+
+    // Opening reads the central directory, keep it outside the lock
+    zip_t* reader = zip_open(GetPath().c_str(), ZIP_RDONLY, nullptr);
+    if (reader == nullptr) {
+        SPDLOG_ERROR("Failed to open zip file \"{}\" for reading", GetPath());
     }
+    return reader;
+}
+
+void O2rArchive::ReleaseReader(zip_t* reader) {
+    const std::lock_guard<std::mutex> lock(mReadersMutex);
+    mIdleReaders.push_back(reader);
+}
+
+void O2rArchive::CloseReaders() {
+    const std::lock_guard<std::mutex> lock(mReadersMutex);
+
+    for (auto reader : mIdleReaders) {
+        zip_discard(reader);
+    }
+    mIdleReaders.clear();
+}
+
+void O2rArchive::IndexEntries() {
+    mEntries.clear();
 
     auto zipNumEntries = zip_get_num_entries(mZipArchive, 0);
-    for (auto i = 0; i < zipNumEntries; i++) {
+    for (zip_int64_t i = 0; i < zipNumEntries; i++) {
         auto zipEntryName = zip_get_name(mZipArchive, i, 0);
 
         // It is possible for directories to have entries in a zip
@@ -83,32 +170,225 @@ bool O2rArchive::Open() {
             continue;
         }
 
+        mEntries[CRC64(zipEntryName)] = i;
         IndexFile(zipEntryName);
     }
+}
+
+std::string O2rArchive::GetIndexPath() {
+    return GetPath() + ".idx";
+}
+
+bool O2rArchive::ReadIndexStamp(IndexStamp& stamp) {
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(GetPath(), error);
+    if (error) {
+        return false;
+    }
+
+    std::ifstream file(GetPath(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    stamp.ArchiveSize = (uint64_t)file.tellg();
+    stamp.ArchiveTime = (int64_t)time.time_since_epoch().count();
+
+    const size_t tailSize = (size_t)std::min<uint64_t>(stamp.ArchiveSize, O2R_INDEX_TAIL_SIZE);
+    std::vector<char> tail(tailSize);
+    file.seekg((std::streamoff)(stamp.ArchiveSize - tailSize));
+    if (!file.read(tail.data(), tailSize)) {
+        return false;
+    }
+    stamp.TailChecksum = crc64(tail.data(), (uint32_t)tailSize);
+
+    return true;
+}
+
+bool O2rArchive::ReadIndex(const IndexStamp& stamp) {
+    std::ifstream file(GetIndexPath(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const size_t size = (size_t)file.tellg();
+    if (size < sizeof(O2rIndexHeader)) {
+        return false;
+    }
+
+    std::vector<char> data(size);
+    file.seekg(0);
+    if (!file.read(data.data(), size)) {
+        return false;
+    }
+
+    O2rIndexHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.Magic, sIndexMagic, sizeof(header.Magic)) != 0 || header.Version != O2R_INDEX_VERSION) {
+        return false;
+    }
+
+    if (header.ArchiveSize != stamp.ArchiveSize || header.ArchiveTime != stamp.ArchiveTime ||
+        header.TailChecksum != stamp.TailChecksum) {
+        SPDLOG_INFO("Index cache of {} is out of date", GetPath());
+        return false;
+    }
+
+    const size_t entriesSize = (size_t)header.EntryCount * sizeof(O2rIndexEntry);
+    if (sizeof(header) + entriesSize + header.NamesSize != size) {
+        SPDLOG_WARN("Index cache of {} is truncated", GetPath());
+        return false;
+    }
+
+    const auto entries = reinterpret_cast<const O2rIndexEntry*>(data.data() + sizeof(header));
+    const char* names = data.data() + sizeof(header) + entriesSize;
+
+    mEntries.clear();
+    mEntries.reserve(header.EntryCount);
+    for (uint32_t i = 0; i < header.EntryCount; i++) {
+        O2rIndexEntry entry;
+        memcpy(&entry, &entries[i], sizeof(entry));
+        if ((uint64_t)entry.NameOffset + entry.NameLength > header.NamesSize) {
+            SPDLOG_WARN("Index cache of {} is corrupt", GetPath());
+            mEntries.clear();
+            return false;
+        }
+
+        mEntries[entry.Hash] = entry.ZipIndex;
+        IndexFile(std::string(names + entry.NameOffset, entry.NameLength));
+    }
+
+    return true;
+}
+
+void O2rArchive::WriteIndex(const IndexStamp& stamp) {
+    std::vector<O2rIndexEntry> entries;
+    std::string names;
+    entries.reserve(mEntries.size());
+
+    for (const auto& [hash, index] : mEntries) {
+        const char* name = zip_get_name(mZipArchive, index, 0);
+        if (name == nullptr) {
+            return;
+        }
+
+        O2rIndexEntry entry;
+        entry.Hash = hash;
+        entry.ZipIndex = index;
+        entry.NameOffset = (uint32_t)names.size();
+        entry.NameLength = (uint32_t)strlen(name);
+        names.append(name, entry.NameLength);
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const O2rIndexEntry& a, const O2rIndexEntry& b) { return a.Hash < b.Hash; });
+
+    O2rIndexHeader header = {};
+    memcpy(header.Magic, sIndexMagic, sizeof(header.Magic));
+    header.Version = O2R_INDEX_VERSION;
+    header.EntryCount = (uint32_t)entries.size();
+    header.ArchiveSize = stamp.ArchiveSize;
+    header.ArchiveTime = stamp.ArchiveTime;
+    header.TailChecksum = stamp.TailChecksum;
+    header.NamesSize = names.size();
+
+    // Written under a temporary name so an interrupted write never leaves a cache that looks valid
+    const std::string indexPath = GetIndexPath();
+    const std::string tempPath = indexPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            // Archives in read-only locations are indexed on every start
+            SPDLOG_DEBUG("Can't write index cache {}", indexPath);
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(O2rIndexEntry));
+        file.write(names.data(), names.size());
+        if (!file.good()) {
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, indexPath, error);
+    if (error) {
+        SPDLOG_WARN("Failed to write index cache {}: {}", indexPath, error.message());
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+bool O2rArchive::OpenWriter() {
+    if (mZipArchive != nullptr) {
+        return true;
+    }
+
+    mZipArchive = zip_open(GetPath().c_str(), ZIP_CREATE, nullptr);
+    return mZipArchive != nullptr;
+}
+
+bool O2rArchive::Open() {
+    const std::unique_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    IndexStamp stamp;
+    const bool hasStamp = ReadIndexStamp(stamp);
+    if (hasStamp && ReadIndex(stamp)) {
+        mIsOpen = true;
+        return true;
+    }
+
+    if (!OpenWriter()) {
+        SPDLOG_ERROR("Failed to load zip file \"{}\"", GetPath());
+        return false;
+    }
+
+    IndexEntries();
+    if (hasStamp) {
+        WriteIndex(stamp);
+    }
+    mIsOpen = true;
 
     return true;
 }
 
 bool O2rArchive::Close() {
-    if (mZipArchive == nullptr) {
+    const std::unique_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    CloseReaders();
+
+    if (!mIsOpen) {
         SPDLOG_ERROR("Cannot close zip file. Zip file not loaded. \"{}\"", GetPath());
         return false;
     }
+    mIsOpen = false;
 
-    if (zip_close(mZipArchive) == -1) {
+    if (mZipArchive != nullptr && zip_close(mZipArchive) == -1) {
         SPDLOG_ERROR("Failed to close zip file \"{}\"", GetPath());
         return false;
     }
+    mZipArchive = nullptr;
 
     return true;
 }
 
 bool O2rArchive::WriteFile(const std::string& filePath, const std::vector<uint8_t>& data) {
-    if (!mZipArchive) {
+    const std::unique_lock<std::shared_mutex> lock(mArchiveMutex);
+
+    if (!mIsOpen) {
         SPDLOG_ERROR("Cannot write to zip: Archive is not open.");
         return false;
     }
 
+    if (!OpenWriter()) {
+        SPDLOG_ERROR("Failed to open zip file \"{}\" for writing", GetPath());
+        return false;
+    }
+
     // Create a new zip source from the data buffer
     zip_source_t* source = zip_source_buffer(mZipArchive, data.data(), data.size(), 0);
     if (!source) {
@@ -123,12 +403,17 @@ bool O2rArchive::WriteFile(const std::string& filePath, const std::vector<uint8_
         return false;
     }
 
+    // Readers still see the archive as it was before the write
+    CloseReaders();
+
     // Save changes to disk
     if (zip_close(mZipArchive) < 0) {
         zip_error_t* error = zip_get_error(mZipArchive);
         SPDLOG_ERROR("Failed to save changes to zip archive: {} ({})", zip_error_strerror(error),
                      zip_error_code_zip(error));
         zip_discard(mZipArchive); // Close zip and discard changes
+        mZipArchive = nullptr;
+        mIsOpen = false;
         return false;
     }
 
@@ -138,10 +423,16 @@ bool O2rArchive::WriteFile(const std::string& filePath, const std::vector<uint8_
     mZipArchive = zip_open(GetPath().c_str(), ZIP_CREATE, nullptr);
     if (mZipArchive == nullptr) {
         SPDLOG_ERROR("Failed to reopen zip file after writing.");
+        mIsOpen = false;
         return false;
     }
 
-    IndexFile(filePath);
+    // Entry indices can move when libzip rewrites the archive
+    IndexEntries();
+    IndexStamp stamp;
+    if (ReadIndexStamp(stamp)) {
+        WriteIndex(stamp);
+    }
 
     // Success
     return true;
@@ -5,6 +5,10 @@
 #include <string>
 #include <stdint.h>
 #include <string>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "zip.h"
 
@@ -28,6 +32,30 @@ class O2rArchive final : virtual public Archive {
     std::shared_ptr<File> LoadFile(uint64_t hash);
 
   private:
-    zip_t* mZipArchive;
+    struct IndexStamp;
+
+    void IndexEntries();
+    std::string GetIndexPath();
+    bool ReadIndexStamp(IndexStamp& stamp);
+    bool ReadIndex(const IndexStamp& stamp);
+    void WriteIndex(const IndexStamp& stamp);
+    bool OpenWriter();
+    std::shared_ptr<File> LoadEntry(zip_t* zipArchive, zip_uint64_t zipEntryIndex);
+    zip_t* AcquireReader();
+    void ReleaseReader(zip_t* reader);
+    void CloseReaders();
+
+    bool mIsOpen = false;
+    // Only opened when the entry index has to be built or the archive is written to. Loads go through the
+    // reader pool, so an archive opened from its index cache never needs it.
+    zip_t* mZipArchive = nullptr;
+    // Entry index of every file by the CRC64 of its name, so loads don't need zip_name_locate
+    std::unordered_map<uint64_t, zip_uint64_t> mEntries;
+    // A zip_t can only be used by one thread at a time, so each load borrows a read-only handle from
+    // this pool. It grows to the number of threads that have loaded from the archive at once.
+    std::vector<zip_t*> mIdleReaders;
+    std::mutex mReadersMutex;
+    // Held shared while loading, exclusively while the archive is written or closed
+    std::shared_mutex mArchiveMutex;
 };
 } // namespace Ship
@@ -11,15 +11,10 @@ ResourceFactoryBinaryBlobV0::ReadResource(std::shared_ptr<Ship::File> file,
     }
 
     auto blob = std::make_shared<Blob>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    uint32_t dataSize = reader->ReadUInt32();
-
-    blob->Data.reserve(dataSize);
-
-    for (uint32_t i = 0; i < dataSize; i++) {
-        blob->Data.push_back(reader->ReadUByte());
-    }
+    uint32_t dataSize = reader.ReadUInt32();
+    blob->Data = reader.ReadArray<uint8_t>(dataSize);
 
     return blob;
 }
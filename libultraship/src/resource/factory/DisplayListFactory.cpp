@@ -160,20 +160,21 @@ ResourceFactoryBinaryDisplayListV0::ReadResource(std::shared_ptr<Ship::File> fil
     }
 
     auto displayList = std::make_shared<DisplayList>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
-    auto ucode = (UcodeHandlers)reader->ReadInt8();
+    auto reader = CreateSpanReader(file, initData);
+    auto ucode = (UcodeHandlers)reader.ReadInt8();
 
     displayList->UCode = ucode;
 
-    while (reader->GetBaseAddress() % 8 != 0) {
-        reader->ReadInt8();
-    }
+    reader.Align(8);
+
+    // Most commands are 64 bits, so this is usually close to the final size
+    displayList->Instructions.reserve(reader.GetRemaining() / sizeof(uint64_t));
 
     size_t idx = 0;
     while (true) {
         Gfx command;
-        command.words.w0 = reader->ReadUInt32();
-        command.words.w1 = reader->ReadUInt32();
+        command.words.w0 = reader.ReadUInt32();
+        command.words.w1 = reader.ReadUInt32();
 
         int8_t opcode = (int8_t)(command.words.w0 >> 24);
         bool isExpanded = opcode == G_SETTIMG_OTR_HASH || opcode == G_DL_OTR_HASH || opcode == G_VTX_OTR_HASH ||
@@ -187,8 +188,8 @@ ResourceFactoryBinaryDisplayListV0::ReadResource(std::shared_ptr<Ship::File> fil
             command.words.trace.valid = true;
 #endif
             displayList->Instructions.push_back(command);
-            command.words.w0 = reader->ReadUInt32();
-            command.words.w1 = reader->ReadUInt32();
+            command.words.w0 = reader.ReadUInt32();
+            command.words.w1 = reader.ReadUInt32();
         }
 
 #ifdef USE_GBI_TRACE
@@ -4,6 +4,24 @@
 
 namespace Fast {
 
+// Textures are used as stored, so when the file is a view into memory that outlives it (a mapped
+// archive, or the buffer it was loaded into) the texture keeps that memory alive and points into it.
+static void ReadImageData(std::shared_ptr<Ship::File> file, std::shared_ptr<Ship::BinaryReader> reader,
+                          std::shared_ptr<Texture> texture) {
+    size_t offset = reader->GetBaseAddress();
+
+    if (file->Storage != nullptr && file->Data != nullptr && offset <= file->Size &&
+        texture->ImageDataSize <= file->Size - offset) {
+        texture->ImageData = reinterpret_cast<uint8_t*>(file->Data + offset);
+        texture->ImageDataOwner = file->Storage;
+        reader->Seek(texture->ImageDataSize, Ship::SeekOffsetType::Current);
+        return;
+    }
+
+    texture->ImageData = new uint8_t[texture->ImageDataSize];
+    reader->Read((char*)texture->ImageData, texture->ImageDataSize);
+}
+
 std::shared_ptr<Ship::IResource>
 ResourceFactoryBinaryTextureV0::ReadResource(std::shared_ptr<Ship::File> file,
                                              std::shared_ptr<Ship::ResourceInitData> initData) {
@@ -18,9 +36,7 @@ ResourceFactoryBinaryTextureV0::ReadResource(std::shared_ptr<Ship::File> file,
     texture->Width = reader->ReadUInt32();
     texture->Height = reader->ReadUInt32();
     texture->ImageDataSize = reader->ReadUInt32();
-    texture->ImageData = new uint8_t[texture->ImageDataSize];
-
-    reader->Read((char*)texture->ImageData, texture->ImageDataSize);
+    ReadImageData(file, reader, texture);
 
     return texture;
 }
@@ -42,9 +58,7 @@ ResourceFactoryBinaryTextureV1::ReadResource(std::shared_ptr<Ship::File> file,
     texture->HByteScale = reader->ReadFloat();
     texture->VPixelScale = reader->ReadFloat();
     texture->ImageDataSize = reader->ReadUInt32();
-    texture->ImageData = new uint8_t[texture->ImageDataSize];
-
-    reader->Read((char*)texture->ImageData, texture->ImageDataSize);
+    ReadImageData(file, reader, texture);
 
     return texture;
 }
@@ -13,24 +13,17 @@ ResourceFactoryBinaryVertexV0::ReadResource(std::shared_ptr<Ship::File> file,
     }
 
     auto vertex = std::make_shared<Vertex>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    uint32_t count = reader->ReadUInt32();
-    vertex->VertexList.reserve(count);
+    uint32_t count = reader.ReadUInt32();
+    vertex->VertexList.resize(count);
 
     for (uint32_t i = 0; i < count; i++) {
-        Vtx data;
-        data.v.ob[0] = reader->ReadInt16();
-        data.v.ob[1] = reader->ReadInt16();
-        data.v.ob[2] = reader->ReadInt16();
-        data.v.flag = reader->ReadUInt16();
-        data.v.tc[0] = reader->ReadInt16();
-        data.v.tc[1] = reader->ReadInt16();
-        data.v.cn[0] = reader->ReadUByte();
-        data.v.cn[1] = reader->ReadUByte();
-        data.v.cn[2] = reader->ReadUByte();
-        data.v.cn[3] = reader->ReadUByte();
-        vertex->VertexList.push_back(data);
+        Vtx& data = vertex->VertexList[i];
+        reader.ReadArray(data.v.ob, 3);
+        data.v.flag = reader.ReadUInt16();
+        reader.ReadArray(data.v.tc, 2);
+        reader.ReadArray(data.v.cn, 4);
     }
 
     return vertex;
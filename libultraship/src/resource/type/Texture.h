@@ -35,6 +35,8 @@ class Texture : public Ship::Resource<uint8_t> {
     float VPixelScale = 1.0;
     uint32_t ImageDataSize;
     uint8_t* ImageData = nullptr;
+    // Set when ImageData points into the file it was read from instead of its own allocation
+    std::shared_ptr<void> ImageDataOwner;
 
     ~Texture();
 };
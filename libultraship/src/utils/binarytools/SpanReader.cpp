@@ -0,0 +1,126 @@
+#include "SpanReader.h"
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPAN_READER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPAN_READER_NEON
+#endif
+
+namespace Ship {
+
+#ifdef SPAN_READER_SSE2
+// SSE2 has no byte shuffle, so bytes are swapped within each 16-bit lane with shifts
+// and the lanes are then reordered with 16-bit shuffles
+static inline __m128i SwapBytes16(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+static inline __m128i SwapBytes32(__m128i v) {
+    v = SwapBytes16(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128i SwapBytes64(__m128i v) {
+    v = SwapBytes16(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+#endif
+
+void ByteSwapArray16(void* data, size_t count) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    size_t i = 0;
+
+#if defined(SPAN_READER_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i* block = reinterpret_cast<__m128i*>(bytes + i * 2);
+        _mm_storeu_si128(block, SwapBytes16(_mm_loadu_si128(block)));
+    }
+#elif defined(SPAN_READER_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u8(bytes + i * 2, vrev16q_u8(vld1q_u8(bytes + i * 2)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint16_t value;
+        memcpy(&value, bytes + i * 2, 2);
+        value = BSWAP16(value);
+        memcpy(bytes + i * 2, &value, 2);
+    }
+}
+
+void ByteSwapArray32(void* data, size_t count) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    size_t i = 0;
+
+#if defined(SPAN_READER_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128i* block = reinterpret_cast<__m128i*>(bytes + i * 4);
+        _mm_storeu_si128(block, SwapBytes32(_mm_loadu_si128(block)));
+    }
+#elif defined(SPAN_READER_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u8(bytes + i * 4, vrev32q_u8(vld1q_u8(bytes + i * 4)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint32_t value;
+        memcpy(&value, bytes + i * 4, 4);
+        value = BSWAP32(value);
+        memcpy(bytes + i * 4, &value, 4);
+    }
+}
+
+void ByteSwapArray64(void* data, size_t count) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    size_t i = 0;
+
+#if defined(SPAN_READER_SSE2)
+    for (; i + 2 <= count; i += 2) {
+        __m128i* block = reinterpret_cast<__m128i*>(bytes + i * 8);
+        _mm_storeu_si128(block, SwapBytes64(_mm_loadu_si128(block)));
+    }
+#elif defined(SPAN_READER_NEON)
+    for (; i + 2 <= count; i += 2) {
+        vst1q_u8(bytes + i * 8, vrev64q_u8(vld1q_u8(bytes + i * 8)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint64_t value;
+        memcpy(&value, bytes + i * 8, 8);
+        value = BSWAP64(value);
+        memcpy(bytes + i * 8, &value, 8);
+    }
+}
+
+void SpanReader::ThrowOutOfRange() {
+    throw std::out_of_range("SpanReader: read past the end of the span");
+}
+
+std::string SpanReader::ReadString() {
+    uint32_t length = (uint32_t)ReadInt32();
+    CheckRange(length);
+
+    std::string result(mData + mPosition, length);
+    mPosition += length;
+    return result;
+}
+
+// Includes the terminator like BinaryReader::ReadCString, and stops at the end of the span without one
+std::string SpanReader::ReadCString() {
+    const char* start = mData + mPosition;
+    const void* end = memchr(start, '\0', mSize - mPosition);
+    size_t length = end != nullptr ? static_cast<const char*>(end) - start + 1 : mSize - mPosition;
+
+    std::string result(start, length);
+    mPosition += length;
+    return result;
+}
+} // namespace Ship
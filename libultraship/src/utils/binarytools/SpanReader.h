@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "endianness.h"
+
+namespace Ship {
+
+// Reverses the byte order of count 2, 4 or 8 byte values in place
+void ByteSwapArray16(void* data, size_t count);
+void ByteSwapArray32(void* data, size_t count);
+void ByteSwapArray64(void* data, size_t count);
+
+/*
+ * Reader over a span of memory it doesn't own, for factories that read many values.
+ *
+ * BinaryReader goes through a Stream with a virtual call and an endian check for every value. This reads
+ * straight from the span with inlined, bounds-checked reads, and ReadArray copies whole arrays at once,
+ * byte-swapping them with SIMD when the data isn't in native byte order. The span has to stay alive while
+ * the reader is used, which for factories is the File being read.
+ */
+class SpanReader {
+  public:
+    SpanReader(const char* data, size_t size, Endianness endianness = Endianness::Native)
+        : mData(data), mSize(size), mEndianness(endianness) {
+    }
+
+    void SetEndianness(Endianness endianness) {
+        mEndianness = endianness;
+    }
+
+    Endianness GetEndianness() const {
+        return mEndianness;
+    }
+
+    size_t GetBaseAddress() const {
+        return mPosition;
+    }
+
+    size_t GetRemaining() const {
+        return mSize - mPosition;
+    }
+
+    void Seek(size_t position) {
+        if (position > mSize) {
+            ThrowOutOfRange();
+        }
+        mPosition = position;
+    }
+
+    void Skip(size_t length) {
+        CheckRange(length);
+        mPosition += length;
+    }
+
+    // Aligns the read position to a multiple of alignment
+    void Align(size_t alignment) {
+        Skip((alignment - mPosition % alignment) % alignment);
+    }
+
+    // Reads a scalar in the reader's byte order
+    template <typename T> T Read() {
+        static_assert(std::is_arithmetic_v<T>, "SpanReader::Read only reads scalars");
+
+        CheckRange(sizeof(T));
+        T result;
+        memcpy(&result, mData + mPosition, sizeof(T));
+        mPosition += sizeof(T);
+
+        if constexpr (sizeof(T) > 1) {
+            if (mEndianness != Endianness::Native) {
+                ByteSwap(&result);
+            }
+        }
+        return result;
+    }
+
+    // Reads count scalars in the reader's byte order to dest
+    template <typename T> void ReadArray(T* dest, size_t count) {
+        static_assert(std::is_arithmetic_v<T>, "SpanReader::ReadArray only reads scalars");
+
+        if (count > GetRemaining() / sizeof(T)) {
+            ThrowOutOfRange();
+        }
+        memcpy(dest, mData + mPosition, count * sizeof(T));
+        mPosition += count * sizeof(T);
+
+        if constexpr (sizeof(T) > 1) {
+            if (mEndianness != Endianness::Native) {
+                ByteSwapArray(dest, count);
+            }
+        }
+    }
+
+    template <typename T> std::vector<T> ReadArray(size_t count) {
+        if (count > GetRemaining() / sizeof(T)) {
+            ThrowOutOfRange();
+        }
+        std::vector<T> result(count);
+        ReadArray(result.data(), count);
+        return result;
+    }
+
+    void Read(char* buffer, size_t length) {
+        CheckRange(length);
+        memcpy(buffer, mData + mPosition, length);
+        mPosition += length;
+    }
+
+    char ReadChar() {
+        return Read<char>();
+    }
+
+    int8_t ReadInt8() {
+        return Read<int8_t>();
+    }
+
+    int16_t ReadInt16() {
+        return Read<int16_t>();
+    }
+
+    int32_t ReadInt32() {
+        return Read<int32_t>();
+    }
+
+    int64_t ReadInt64() {
+        return Read<int64_t>();
+    }
+
+    uint8_t ReadUByte() {
+        return Read<uint8_t>();
+    }
+
+    uint16_t ReadUInt16() {
+        return Read<uint16_t>();
+    }
+
+    uint32_t ReadUInt32() {
+        return Read<uint32_t>();
+    }
+
+    uint64_t ReadUInt64() {
+        return Read<uint64_t>();
+    }
+
+    // Unlike BinaryReader these don't reject NaN, the callers that read floats in bulk don't either
+    float ReadFloat() {
+        return Read<float>();
+    }
+
+    double ReadDouble() {
+        return Read<double>();
+    }
+
+    std::string ReadString();
+    std::string ReadCString();
+
+  private:
+    [[noreturn]] static void ThrowOutOfRange();
+
+    void CheckRange(size_t length) const {
+        if (length > mSize - mPosition) {
+            ThrowOutOfRange();
+        }
+    }
+
+    template <typename T> static void ByteSwap(T* value) {
+        if constexpr (sizeof(T) == 2) {
+            uint16_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            bits = BSWAP16(bits);
+            memcpy(value, &bits, sizeof(bits));
+        } else if constexpr (sizeof(T) == 4) {
+            uint32_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            bits = BSWAP32(bits);
+            memcpy(value, &bits, sizeof(bits));
+        } else if constexpr (sizeof(T) == 8) {
+            uint64_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            bits = BSWAP64(bits);
+            memcpy(value, &bits, sizeof(bits));
+        }
+    }
+
+    template <typename T> static void ByteSwapArray(T* data, size_t count) {
+        if constexpr (sizeof(T) == 2) {
+            ByteSwapArray16(data, count);
+        } else if constexpr (sizeof(T) == 4) {
+            ByteSwapArray32(data, count);
+        } else if constexpr (sizeof(T) == 8) {
+            ByteSwapArray64(data, count);
+        }
+    }
+
+    const char* mData;
+    size_t mSize;
+    size_t mPosition = 0;
+    Endianness mEndianness;
+};
+} // namespace Ship
@@ -0,0 +1,79 @@
+#include "ViewStream.h"
+#include <cstring>
+#include <stdexcept>
+
+Ship::ViewStream::ViewStream(std::shared_ptr<void> owner, char* data, size_t size)
+    : mOwner(std::move(owner)), mData(data), mSize(size) {
+    mBaseAddress = 0;
+}
+
+Ship::ViewStream::~ViewStream() {
+}
+
+uint64_t Ship::ViewStream::GetLength() {
+    return mSize;
+}
+
+void Ship::ViewStream::Seek(int32_t offset, SeekOffsetType seekType) {
+    if (seekType == SeekOffsetType::Start) {
+        mBaseAddress = offset;
+    } else if (seekType == SeekOffsetType::Current) {
+        mBaseAddress += offset;
+    } else if (seekType == SeekOffsetType::End) {
+        mBaseAddress = mSize - 1 - offset;
+    }
+}
+
+// Same bounds behaviour as MemoryStream, which reads through std::vector::at
+void Ship::ViewStream::CheckRange(size_t length) {
+    if (mBaseAddress > mSize || length > mSize - mBaseAddress) {
+        throw std::out_of_range("ViewStream: read or write past the end of the view");
+    }
+}
+
+std::unique_ptr<char[]> Ship::ViewStream::Read(size_t length) {
+    CheckRange(length);
+
+    std::unique_ptr<char[]> result = std::make_unique<char[]>(length);
+    memcpy(result.get(), mData + mBaseAddress, length);
+    mBaseAddress += length;
+
+    return result;
+}
+
+void Ship::ViewStream::Read(const char* dest, size_t length) {
+    CheckRange(length);
+
+    memcpy((void*)dest, mData + mBaseAddress, length);
+    mBaseAddress += length;
+}
+
+int8_t Ship::ViewStream::ReadByte() {
+    CheckRange(1);
+
+    return mData[mBaseAddress++];
+}
+
+// A view can't grow, writes are only allowed within it
+void Ship::ViewStream::Write(char* srcBuffer, size_t length) {
+    CheckRange(length);
+
+    memcpy(mData + mBaseAddress, srcBuffer, length);
+    mBaseAddress += length;
+}
+
+void Ship::ViewStream::WriteByte(int8_t value) {
+    CheckRange(1);
+
+    mData[mBaseAddress++] = value;
+}
+
+std::vector<char> Ship::ViewStream::ToVector() {
+    return std::vector<char>(mData, mData + mSize);
+}
+
+void Ship::ViewStream::Flush() {
+}
+
+void Ship::ViewStream::Close() {
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Stream.h"
+
+namespace Ship {
+// Stream over memory it doesn't own, such as a file inside a memory-mapped archive. The owner is only
+// held to keep the memory alive while the stream is in use.
+class ViewStream : public Stream {
+  public:
+    ViewStream(std::shared_ptr<void> owner, char* data, size_t size);
+    ~ViewStream();
+
+    uint64_t GetLength() override;
+
+    void Seek(int32_t offset, SeekOffsetType seekType) override;
+
+    std::unique_ptr<char[]> Read(size_t length) override;
+    void Read(const char* dest, size_t length) override;
+    int8_t ReadByte() override;
+
+    void Write(char* srcBuffer, size_t length) override;
+    void WriteByte(int8_t value) override;
+
+    std::vector<char> ToVector() override;
+
+    void Flush() override;
+    void Close() override;
+
+  protected:
+    void CheckRange(size_t length);
+
+    std::shared_ptr<void> mOwner;
+    char* mData;
+    size_t mSize;
+};
+} // namespace Ship
@@ -4,6 +4,7 @@
 #include "audiothread_cmd.h"
 #include "audioseq_cmd.h"
 #include "port/Engine.h"
+#include "port/resource/loaders/AudioLoader.h"
 
 void Audio_SetModulationAndPlaySfx(f32* sfxSource, u32 sfxId, f32 freqMod);
 s32 Audio_GetCurrentVoice(void);
@@ -635,6 +636,8 @@ void Audio_LoadInstruments(void) {
 
 void Audio_LoadAquasSequence(void) {
     if (sAudioSpecId == AUDIOSPEC_AQ) {
+        // @port:
+        Audio_PreloadSequence(NA_BGM_STAGE_AQ);
         AUDIOCMD_GLOBAL_SYNC_LOAD_SEQ_PARTS(NA_BGM_STAGE_AQ, 0);
     }
 }
@@ -657,6 +660,8 @@ void Audio_StartSequence(u8 seqPlayId, u8 seqId, u8 seqArgs, u16 fadeInTime) {
     s32 pad;
 
     if (!sStartSeqDisabled || (seqPlayId == SEQ_PLAYER_SFX)) {
+        // @port: Starts loading the fonts on the resource workers while the command waits for the audio thread
+        Audio_PreloadSequence(seqId);
         AUDIOCMD_GLOBAL_INIT_SEQPLAYER((u32) seqPlayId, (u32) seqId, 0, fadeInTime);
         sActiveSequences[seqPlayId].prevSeqId = sActiveSequences[seqPlayId].seqId = seqId | ((seqArgs) << 8);
         if (sActiveSequences[seqPlayId].mainVolume.mod != 1.0f) {
@@ -2774,6 +2779,8 @@ void Audio_InitSounds(void) {
     Audio_ResetActiveSequencesAndVolume();
     Audio_ResetSfx();
     if (GameEngine_HasVersion(SF64_VER_EU)) {
+        // @port:
+        Audio_PreloadSequence(NA_BGM_VO_LYLAT);
         AUDIOCMD_GLOBAL_SYNC_LOAD_SEQ_PARTS(NA_BGM_VO_LYLAT, 0);
     }
     Audio_StartSequence(SEQ_PLAYER_VOICE, NA_BGM_VO, -1, 1);
@@ -2834,6 +2841,18 @@ void Audio_StartReset(u8 oldSpecId) {
     Audio_ResetSfx();
 }
 
+// @port: Resets the audio heap on the current spec and drops everything playing, like a spec change does, so offline
+// renders start from the same state every time. The reset completes over the next audio updates.
+void Audio_ResetForRender(void) {
+    AudioThread_ResetAudioHeap(sAudioSpecId);
+    Audio_StartReset(sAudioSpecId);
+    AUDIOCMD_GLOBAL_STOP_AUDIOCMDS();
+}
+
+bool Audio_IsResetComplete(void) {
+    return sAudioResetStatus == AUDIORESET_READY;
+}
+
 void Audio_Update(void) {
     if (Audio_HandleReset() == AUDIORESET_READY) {
         Audio_ProcessSfxRequests();
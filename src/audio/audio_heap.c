@@ -1,5 +1,7 @@
 #include "sys.h"
 #include "sf64audio_provisional.h"
+#include "audio/mixer.h"
+#include "port/Engine.h"
 
 void AudioHeap_DiscardSampleCacheEntry(SampleCacheEntry* entry);
 void AudioHeap_Init(void);
@@ -11,6 +13,10 @@ void* AudioHeap_SearchRegularCaches(s32 tableType, s32 cache, s32 id);
 void* AudioHeap_SearchPermanentCache(s32 tableType, s32 id);
 SampleCacheEntry* AudioHeap_AllocPersistentSampleCacheEntry(u32);
 
+// @port: Ring buffers for the high quality reverb and for rates above 32 kHz, which don't fit the misc pool
+#define PORT_REVERB_MAX_WINDOW (0x100 * 64)
+static s16 sPortReverbRingBufs[ARRAY_COUNT(gSynthReverbs)][2][PORT_REVERB_MAX_WINDOW];
+
 static const char devstr00[] = "Warning:Kill Note  %x \n";
 static const char devstr01[] = "Kill Voice %d (ID %d) %d\n";
 static const char devstr02[] = "Warning: Running Sequence's data disappear!\n";
@@ -633,9 +639,17 @@ void AudioHeap_Init(void) {
     u32 temporarySize;
     u32 cachePoolSize;
     u32 miscPoolSize;
+    s32 windowSize;
+    s32 highQuality;
 
     gSampleDmaCount = 0;
     gAudioBufferParams.samplingFrequency = spec->samplingFrequency;
+    // @port: Synthesize at the rate the audio player runs at, so nothing resamples the output. The pitches follow
+    // through resampleRate, and the reverb windows are scaled below.
+    if (GameEngine_GetSampleRate() != 0) {
+        gAudioBufferParams.samplingFrequency = GameEngine_GetSampleRate();
+    }
+    Mixer_SetSampleRate(gAudioBufferParams.samplingFrequency);
     gAudioBufferParams.aiSamplingFrequency = osAiSetFrequency(gAudioBufferParams.samplingFrequency);
     gAudioBufferParams.samplesPerFrameTarget = ALIGN16(gAudioBufferParams.samplingFrequency / gRefreshRate);
 
@@ -721,8 +735,26 @@ void AudioHeap_Init(void) {
         reverb->leakLtR = settings->leakLtR;
         reverb->useReverb = 8;
 
-        reverb->leftRingBuf = AudioHeap_AllocZeroed(&gMiscPool, reverb->windowSize * 2);
-        reverb->rightRingBuf = AudioHeap_AllocZeroed(&gMiscPool, reverb->windowSize * 2);
+        // @port: The windows are counted in samples, so they're scaled to last as long at other output rates. The
+        // high quality reverb runs downsampled reverbs at the output rate, over a window as long in time.
+        highQuality = (reverb->downsampleRate != 1) && CVarGetInteger("gAudioHighQualityReverb", 0);
+        windowSize = ALIGN16(reverb->windowSize * gAudioBufferParams.samplingFrequency / 32000);
+        if (highQuality) {
+            windowSize *= reverb->downsampleRate;
+        }
+        if ((windowSize != reverb->windowSize) && (windowSize <= PORT_REVERB_MAX_WINDOW)) {
+            reverb->windowSize = windowSize;
+            if (highQuality) {
+                reverb->downsampleRate = 1;
+            }
+            reverb->leftRingBuf = sPortReverbRingBufs[i][0];
+            reverb->rightRingBuf = sPortReverbRingBufs[i][1];
+            memset(reverb->leftRingBuf, 0, reverb->windowSize * 2);
+            memset(reverb->rightRingBuf, 0, reverb->windowSize * 2);
+        } else {
+            reverb->leftRingBuf = AudioHeap_AllocZeroed(&gMiscPool, reverb->windowSize * 2);
+            reverb->rightRingBuf = AudioHeap_AllocZeroed(&gMiscPool, reverb->windowSize * 2);
+        }
         reverb->nextRingBufPos = 0;
         reverb->unk_20 = 0;
         reverb->curFrame = 0;
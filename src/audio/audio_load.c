@@ -6,6 +6,7 @@
 #include "port/Engine.h"
 #include "endianness.h"
 #include "port/resource/loaders/AudioLoader.h"
+#include "audio/mixer.h"
 
 s32 D_80146D80;
 s32 PAD_80146D88[2];
@@ -405,6 +406,11 @@ void AudioLoad_SyncInitSeqPlayerInternal(s32 playerIdx, s32 seqId, s32 arg2) {
 
     for (numFonts; numFonts > 0; numFonts--) {
         fontId = gSeqFontTable[index++];
+        // @port: The sound effect and voice players run for the whole game and can't wait on a font without
+        // dropping sounds, so they start with all of their fonts loaded
+        if ((playerIdx == SEQ_PLAYER_SFX) || (playerIdx == SEQ_PLAYER_VOICE)) {
+            Audio_WaitForFont(fontId);
+        }
         AudioLoad_SyncLoadFont(fontId);
     }
 
@@ -422,6 +428,27 @@ void AudioLoad_SyncInitSeqPlayerInternal(s32 playerIdx, s32 seqId, s32 arg2) {
     gSeqPlayers[playerIdx].finished = false;
 }
 
+// @port: Retries the fonts of a sequence that were still loading in the background when it started. Returns whether
+// all of them are done, fonts that failed to load included.
+s32 AudioLoad_SeqFontsLoaded(s32 seqId) {
+    s32 index = BSWAP16(*((u16*) gSeqFontTable + seqId));
+    s32 numFonts = gSeqFontTable[index++];
+    s32 loaded = true;
+    s32 fontId;
+
+    for (numFonts; numFonts > 0; numFonts--) {
+        fontId = gSeqFontTable[index++];
+        if (gFontLoadStatus[fontId] == LOAD_STATUS_IN_PROGRESS) {
+            AudioLoad_SyncLoadFont(fontId);
+            if (gFontLoadStatus[fontId] == LOAD_STATUS_IN_PROGRESS) {
+                loaded = false;
+            }
+        }
+    }
+
+    return loaded;
+}
+
 void* AudioLoad_SyncLoadSeq(s32 seqId) {
     AudioTable* table = AudioLoad_GetLoadTable(SEQUENCE_TABLE);
     char* seqPath = ResourceGetNameByCrc((uint64_t) table->entries[seqId].romAddr);
@@ -509,6 +536,14 @@ void* AudioLoad_SyncLoadFont(s32 fontId) {
     return fontData;
 }
 
+// @port: Fonts load in the background. One that failed is not loaded, so sequences stop waiting on it.
+s32 AudioLoad_GetFontLoadStatus(s32 fontId, void* fontData) {
+    if (fontData != NULL) {
+        return LOAD_STATUS_COMPLETE;
+    }
+    return Audio_FontLoadFailed(fontId) ? LOAD_STATUS_NOT_LOADED : LOAD_STATUS_IN_PROGRESS;
+}
+
 void* AudioLoad_SyncLoad(u32 tableType, u32 id, s32* didAllocate) {
     u32 size;
     AudioTable* table;
@@ -533,9 +568,11 @@ void* AudioLoad_SyncLoad(u32 tableType, u32 id, s32* didAllocate) {
                 gSeqLoadStatus[id] = LOAD_STATUS_COMPLETE;
                 return ResourceGetDataByCrc((uint64_t) table->entries[id].romAddr);
             case FONT_TABLE:
-                gFontLoadStatus[id] = LOAD_STATUS_COMPLETE;
+                // @port: The font may still be loading in the background
+                ramAddr = (u8*) Audio_LoadFont(table->entries[id], id);
+                gFontLoadStatus[id] = AudioLoad_GetFontLoadStatus(id, ramAddr);
                 // ramAddr = AudioHeap_AllocCached(tableType, size, CACHE_PERSISTENT, id);
-                return Audio_LoadFont(table->entries[id], id);
+                return ramAddr;
             case SAMPLE_TABLE:
                 loadStatus = 0;
                 break;
@@ -621,7 +658,10 @@ void AudioLoad_RelocateFont(s32 fontId, uintptr_t fontBaseAddr, SampleBankRelocI
     AudioTable* table = AudioLoad_GetLoadTable(FONT_TABLE);
     SoundFont* font = Audio_LoadFont(table->entries[fontId], fontId);
 
-    gSoundFontList[fontId] = *font;
+    // @port: Filled in on first use instead while the font is still loading
+    if (font != NULL) {
+        gSoundFontList[fontId] = *font;
+    }
 }
 
 void AudioLoad_SyncDma(uintptr_t devAddr, u8* ramAddr, u32 size, s32 medium) {
@@ -722,9 +762,11 @@ void* AudioLoad_AsyncLoadInner(s32 tableType, s32 id, s32 nChunks, s32 retData,
             osSendMesg(retQueue, OS_MESG_32(retData << 0x18), OS_MESG_NOBLOCK);
             return ResourceGetDataByCrc((uint64_t) table->entries[id].romAddr);
         case FONT_TABLE:
-            gFontLoadStatus[id] = LOAD_STATUS_COMPLETE;
+            // @port: The font may still be loading in the background
+            ramAddr = (u8*) Audio_LoadFont(table->entries[id], id);
+            gFontLoadStatus[id] = AudioLoad_GetFontLoadStatus(id, ramAddr);
             osSendMesg(retQueue, OS_MESG_32(retData << 0x18), OS_MESG_NOBLOCK);
-            return Audio_LoadFont(table->entries[id], id);
+            return ramAddr;
         case SAMPLE_TABLE:
             gSampleFontLoadStatus[id] = LOAD_STATUS_COMPLETE;
             // LTODO: Validate this
@@ -828,6 +870,9 @@ void AudioLoad_Init(void) {
     s32 numFonts;
     void* ramAddr;
 
+    // @port: Before the audio thread or any synthesis worker mixes
+    Mixer_Init();
+
     gAudioResetTimer = 0;
     // TODO: osTVType should be unnecessary
     gMaxTempoTvTypeFactors = 16.713f;
@@ -65,6 +65,43 @@ int testBits(void) {
 }
 #endif
 
+typedef struct {
+    f32 frontLeft;
+    f32 frontRight;
+    f32 rearLeft;
+    f32 rearRight;
+    f32 rearMusicVolume;
+    f32 masterVolume;
+} NotePanSettings;
+
+static NotePanSettings sNotePanSettings;
+static u32 sNotePanSettingsVersion;
+static bool sNotePanSettingsValid = false;
+
+// Audio_InitNoteSub runs for every playing note, only reread the settings when a CVar changed
+static void Audio_UpdateNotePanSettings(void) {
+    if (sNotePanSettingsValid && (sNotePanSettingsVersion == CVarGetVersion())) {
+        return;
+    }
+
+    sNotePanSettingsVersion = CVarGetVersion();
+    sNotePanSettingsValid = true;
+
+    // Speaker angles in radians
+    sNotePanSettings.frontLeft = (CVarGetInteger("gPositionFrontLeft", 240) - 90) * (M_PI / 180.0f);
+    sNotePanSettings.frontRight = (CVarGetInteger("gPositionFrontRight", 300) - 90) * (M_PI / 180.0f);
+    sNotePanSettings.rearLeft = (CVarGetInteger("gPositionRearLeft", 160) - 90) * (M_PI / 180.0f);
+    sNotePanSettings.rearRight = (CVarGetInteger("gPositionRearRight", 20) - 90) * (M_PI / 180.0f);
+    sNotePanSettings.rearMusicVolume = CVarGetFloat("gVolumeRearMusic", 1.0f);
+    sNotePanSettings.masterVolume = CVarGetFloat("gGameMasterVolume", 1.0f);
+}
+
+// @port: The delays are counted in 32 kHz samples. Scaled to the output rate so the delay between the ears stays as
+// long, in whole samples.
+static u8 Audio_GetHaasEffectDelaySize(s32 index) {
+    return gHaasEffectDelaySizes[index] / sizeof(s16) * gAudioBufferParams.samplingFrequency / 32000 * sizeof(s16);
+}
+
 void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
     NoteSubEu* noteSub;
     f32 panVolumeLeft = 0, panVolumeRight = 0, panVolumeRearLeft = 0, panVolumeRearRight = 0, panVolumeCenter = 0;
@@ -80,6 +117,7 @@ void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
     // testBits();
 
     Audio_NoteSetResamplingRate(note, noteAttr->freqMod);
+    Audio_UpdateNotePanSettings();
     noteSub = &note->noteSubEu;
     velocity = noteAttr->velocity;
     pan = noteAttr->pan;
@@ -93,8 +131,8 @@ void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
             if (var_a0 >= ARRAY_COUNT(gHaasEffectDelaySizes)) {
                 var_a0 = ARRAY_COUNT(gHaasEffectDelaySizes) - 1;
             }
-            noteSub->rightDelaySize = gHaasEffectDelaySizes[var_a0];
-            noteSub->leftDelaySize = gHaasEffectDelaySizes[ARRAY_COUNT(gHaasEffectDelaySizes) - 1 - var_a0];
+            noteSub->rightDelaySize = Audio_GetHaasEffectDelaySize(var_a0);
+            noteSub->leftDelaySize = Audio_GetHaasEffectDelaySize(ARRAY_COUNT(gHaasEffectDelaySizes) - 1 - var_a0);
             noteSub->bitField0.stereoStrongRight = false;
             noteSub->bitField0.stereoStrongLeft = false;
             noteSub->bitField0.usesHeadsetPanEffects = true;
@@ -146,10 +184,10 @@ void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
             float pan_angle = ((float) pan) / 128 * 2 * M_PI;
 
             // Speaker angles in radians
-            const float front_left = (CVarGetInteger("gPositionFrontLeft", 240) - 90) * (M_PI / 180.0f);
-            const float front_right = (CVarGetInteger("gPositionFrontRight", 300) - 90) * (M_PI / 180.0f);
-            const float rear_left = (CVarGetInteger("gPositionRearLeft", 160) - 90) * (M_PI / 180.0f);
-            const float rear_right = (CVarGetInteger("gPositionRearRight", 20) - 90) * (M_PI / 180.0f);
+            const float front_left = sNotePanSettings.frontLeft;
+            const float front_right = sNotePanSettings.frontRight;
+            const float rear_left = sNotePanSettings.rearLeft;
+            const float rear_right = sNotePanSettings.rearRight;
 
             // Calculate volumes using cosine panning law
             panVolumeLeft = fmaxf(0, cosf(pan_angle - front_left));      // Front Left
@@ -160,7 +198,7 @@ void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
             panVolumeLeft = gStereoPanVolume[pan];
             panVolumeRight = gStereoPanVolume[ARRAY_COUNT(gStereoPanVolume) - 1 - pan];
 
-            f32 rearMusicVolume = CVarGetFloat("gVolumeRearMusic", 1.0f);
+            f32 rearMusicVolume = sNotePanSettings.rearMusicVolume;
             panVolumeRearLeft = gStereoPanVolume[pan] * rearMusicVolume;
             panVolumeRearRight = gStereoPanVolume[ARRAY_COUNT(gStereoPanVolume) - 1 - pan] * rearMusicVolume;
         }
@@ -173,7 +211,7 @@ void Audio_InitNoteSub(Note* note, NoteAttributes* noteAttr) {
         velocity = 1.0f;
     }
 
-    float master_vol = CVarGetFloat("gGameMasterVolume", 1.0f);
+    float master_vol = sNotePanSettings.masterVolume;
     noteSub->panVolLeft = (s32) (velocity * panVolumeLeft * 4095.999f) * master_vol;
     noteSub->panVolRight = (s32) (velocity * panVolumeRight * 4095.999f) * master_vol;
     noteSub->panVolRLeft = (s32) (velocity * panVolumeRearLeft * 4095.999f) * master_vol;
@@ -224,7 +262,15 @@ Instrument* Audio_GetInstrument(s32 fontId, s32 instId) {
     // fontId = 7;
 
     if (gSoundFontList[fontId].instruments == NULL) {
-        gSoundFontList[fontId] = *Audio_LoadFont(gSoundFontTable->entries[fontId], fontId);
+        // @port: Played like an unloaded font while it is still loading in the background
+        SoundFont* font = Audio_LoadFont(gSoundFontTable->entries[fontId], fontId);
+
+        if (font == NULL) {
+            Audio_ReportMissingFont(fontId);
+            D_80155D88 = fontId + 0x10000000;
+            return NULL;
+        }
+        gSoundFontList[fontId] = *font;
     }
 
     if ((gFontLoadStatus[fontId] < 2) != 0) {
@@ -249,7 +295,15 @@ Drum* Audio_GetDrum(s32 fontId, s32 drumId) {
 
     // LTODO: Remove this
     if (gSoundFontList[fontId].drums == NULL) {
-        gSoundFontList[fontId] = *Audio_LoadFont(gSoundFontTable->entries[fontId], fontId);
+        // @port: Played like an unloaded font while it is still loading in the background
+        SoundFont* font = Audio_LoadFont(gSoundFontTable->entries[fontId], fontId);
+
+        if (font == NULL) {
+            Audio_ReportMissingFont(fontId);
+            D_80155D88 = fontId + 0x10000000;
+            return NULL;
+        }
+        gSoundFontList[fontId] = *font;
     }
 
     if ((gFontLoadStatus[fontId] < 2) != 0) {
@@ -286,7 +340,7 @@ void Audio_NoteDisable(Note* note) {
     if (note->noteSubEu.bitField0.needsInit == true) {
         note->noteSubEu.bitField0.needsInit = false;
     }
-    note->playbackState.priority = 0;
+    Audio_SetNotePriority(note, 0);
     note->noteSubEu.bitField0.enabled = false;
     note->playbackState.unk_04 = 0;
     note->playbackState.parentLayer = NO_LAYER;
@@ -316,7 +370,7 @@ void Audio_ProcessNotes(void) {
             if ((note != playbackState->parentLayer->note) && (playbackState->unk_04 == 0)) {
                 playbackState->adsr.action.asByte |= 0x10;
                 playbackState->adsr.fadeOutVel = gAudioBufferParams.ticksPerUpdateInv;
-                playbackState->priority = 1;
+                Audio_SetNotePriority(note, 1);
                 playbackState->unk_04 = 2;
                 goto out;
             } else {
@@ -324,7 +378,7 @@ void Audio_ProcessNotes(void) {
                     (playbackState->priority <= 0)) {
                     if (playbackState->parentLayer->channel->seqPlayer == NULL) {
                         AudioSeq_SequenceChannelDisable(playbackState->parentLayer->channel);
-                        playbackState->priority = 1;
+                        Audio_SetNotePriority(note, 1);
                         playbackState->unk_04 = 1;
                         continue;
                     }
@@ -336,7 +390,7 @@ void Audio_ProcessNotes(void) {
                 Audio_SeqLayerNoteRelease(playbackState->parentLayer);
                 Audio_AudioListRemove(note);
                 Audio_AudioListPushFront(&note->listItem.pool->decaying, &note->listItem);
-                playbackState->priority = 1;
+                Audio_SetNotePriority(note, 1);
                 playbackState->unk_04 = 2;
             }
         } else if ((playbackState->unk_04 == 0) && (playbackState->priority > 0)) {
@@ -451,7 +505,7 @@ void Audio_SeqLayerDecayRelease(SequenceLayer* layer, s32 arg1) {
                     note->noteSubEu.bitField0.finished = 1;
                 }
             }
-            note->playbackState.priority = 1;
+            Audio_SetNotePriority(note, 1);
             note->playbackState.prevParentLayer = note->playbackState.parentLayer;
             note->playbackState.parentLayer = NO_LAYER;
 
@@ -551,9 +605,31 @@ void Audio_InitNoteLists(NotePool* pool) {
     pool->active.pool = pool;
 }
 
+// @port: The index each note is counted in and the priority it's counted under, by note number. The notes of any
+// audio spec fit.
+static NotePriorityIndex* sNoteIndexes[64];
+static u8 sNoteIndexedPriorities[64];
+
+// @port: Empties a pool's indexes, for when the notes counted in them are gone
+static void Audio_ClearNoteIndex(NotePool* pool) {
+    memset(&pool->releasingIndex, 0, sizeof(pool->releasingIndex));
+    memset(&pool->activeIndex, 0, sizeof(pool->activeIndex));
+}
+
 void Audio_InitNoteFreeList(void) {
     s32 i;
 
+    // @port: The notes were just allocated, so nothing is counted in any pool's index anymore
+    Audio_ClearNoteIndex(&gNoteFreeLists);
+    for (i = 0; i < ARRAY_COUNT(gSeqPlayers); i++) {
+        Audio_ClearNoteIndex(&gSeqPlayers[i].notePool);
+    }
+    for (i = 0; i < ARRAY_COUNT(gSeqChannels); i++) {
+        Audio_ClearNoteIndex(&gSeqChannels[i].notePool);
+    }
+    Audio_ClearNoteIndex(&gSeqChannelNone.notePool);
+    memset(sNoteIndexes, 0, sizeof(sNoteIndexes));
+
     Audio_InitNoteLists(&gNoteFreeLists);
     for (i = 0; i < gNumNotes; i++) {
         gNotes[i].listItem.u.value = &gNotes[i];
@@ -650,6 +726,10 @@ void Audio_AudioListPushFront(AudioListItem* list, AudioListItem* item) {
         list->next = item;
         list->u.count++;
         item->pool = list->pool;
+        // @port: Note lists are indexed by priority
+        if (list->pool != NULL) {
+            Audio_SetNoteList(item->u.value, list);
+        }
     }
 }
 
@@ -659,16 +739,108 @@ void Audio_AudioListRemove(Note* note) {
         note->listItem.prev->next = note->listItem.next;
         note->listItem.next->prev = note->listItem.prev;
         note->listItem.prev = NULL;
+        // @port: Note lists are indexed by priority
+        Audio_SetNoteList(note, NULL);
+    }
+}
+
+// @port: Moves the note's count from the index it's in to index, under its current priority
+static void Audio_IndexNote(Note* note, NotePriorityIndex* index) {
+    s32 noteIndex = note - gNotes;
+    NotePriorityIndex* prevIndex = sNoteIndexes[noteIndex];
+    u8 prevPriority = sNoteIndexedPriorities[noteIndex];
+    u8 priority = note->playbackState.priority;
+
+    if (prevIndex != NULL) {
+        if (--prevIndex->counts[prevPriority] == 0) {
+            prevIndex->present[prevPriority >> 6] &= ~(1ULL << (prevPriority & 63));
+        }
+    }
+    if (index != NULL) {
+        if (index->counts[priority]++ == 0) {
+            index->present[priority >> 6] |= 1ULL << (priority & 63);
+        }
     }
+    sNoteIndexes[noteIndex] = index;
+    sNoteIndexedPriorities[noteIndex] = priority;
+}
+
+// @port: Index of a note list, only the lists notes are stolen from have one
+static NotePriorityIndex* Audio_GetNoteListIndex(AudioListItem* list) {
+    if ((list == NULL) || (list->pool == NULL)) {
+        return NULL;
+    }
+    if (list == &list->pool->releasing) {
+        return &list->pool->releasingIndex;
+    }
+    if (list == &list->pool->active) {
+        return &list->pool->activeIndex;
+    }
+    return NULL;
+}
+
+// @port: Called when the note joins list, or leaves its list with NULL
+void Audio_SetNoteList(Note* note, AudioListItem* list) {
+    Audio_IndexNote(note, Audio_GetNoteListIndex(list));
+}
+
+// @port: Every priority change goes through here, so the index the note is counted in stays current
+void Audio_SetNotePriority(Note* note, s32 priority) {
+    note->playbackState.priority = priority;
+    if (sNoteIndexes[note - gNotes] != NULL) {
+        Audio_IndexNote(note, sNoteIndexes[note - gNotes]);
+    }
+}
+
+// @port: Lowest priority counted in index, or 256 when it's empty
+static s32 Audio_GetLowestNotePriority(NotePriorityIndex* index) {
+    s32 i;
+    s32 priority;
+    u64 bits;
+
+    for (i = 0; i < ARRAY_COUNT(index->present); i++) {
+        if (index->present[i] != 0) {
+            bits = index->present[i];
+            priority = i << 6;
+            while ((bits & 0xFF) == 0) {
+                bits >>= 8;
+                priority += 8;
+            }
+            while ((bits & 1) == 0) {
+                bits >>= 1;
+                priority++;
+            }
+            return priority;
+        }
+    }
+    return 256;
 }
 
 Note* Audio_FindNodeWithPrioLessThan(AudioListItem* item, s32 priority) {
     AudioListItem* priorityItem;
     AudioListItem* nextItem = item->next;
+    NotePriorityIndex* index = Audio_GetNoteListIndex(item);
+    s32 lowestPriority;
 
     if (nextItem == item) {
         return NULL;
     }
+
+    // @port: The index gives the lowest priority in the list, so the list is only searched when it holds a note to
+    // steal. The walk below takes the last note with the lowest priority, which is the first one from the back.
+    if (index != NULL) {
+        lowestPriority = Audio_GetLowestNotePriority(index);
+        if (lowestPriority >= priority) {
+            return NULL;
+        }
+        for (priorityItem = item->prev; priorityItem != item; priorityItem = priorityItem->prev) {
+            if (((Note*) priorityItem->u.value)->playbackState.priority == lowestPriority) {
+                return (Note*) priorityItem->u.value;
+            }
+        }
+        return NULL;
+    }
+
     priorityItem = nextItem;
     for (nextItem; nextItem != item; nextItem = nextItem->next) {
         if (((Note*) nextItem->u.value)->playbackState.priority <=
@@ -694,7 +866,7 @@ void Audio_NoteInitForLayer(Note* note, SequenceLayer* layer) {
 
     note->playbackState.prevParentLayer = NO_LAYER;
     note->playbackState.parentLayer = layer;
-    note->playbackState.priority = layer->channel->notePriority;
+    Audio_SetNotePriority(note, layer->channel->notePriority);
     layer->ignoreDrumPan = 1;
     layer->unk_3 = 3;
     layer->note = note;
@@ -728,7 +900,7 @@ void func_80012E28(Note* note, SequenceLayer* layer) {
 
 void Audio_NoteReleaseAndTakeOwnership(Note* note, SequenceLayer* layer) {
     note->playbackState.wantedParentLayer = layer;
-    note->playbackState.priority = layer->channel->notePriority;
+    Audio_SetNotePriority(note, layer->channel->notePriority);
     note->playbackState.adsr.fadeOutVel = gAudioBufferParams.ticksPerUpdateInv;
     note->playbackState.adsr.action.asByte |= 0x10;
 }
@@ -780,11 +952,11 @@ Note* Audio_AllocNoteFromActive(NotePool* pool, SequenceLayer* layer) {
         Audio_AudioListRemove(aNote);
         func_80012E28(aNote, layer);
         AudioSeq_AudioListPushBack(&pool->releasing, &aNote->listItem);
-        aNote->playbackState.priority = layer->channel->notePriority;
+        Audio_SetNotePriority(aNote, layer->channel->notePriority);
         return aNote;
     }
     rNote->playbackState.wantedParentLayer = layer;
-    rNote->playbackState.priority = layer->channel->notePriority;
+    Audio_SetNotePriority(rNote, layer->channel->notePriority);
     return rNote;
 }
 
@@ -850,7 +1022,7 @@ void Audio_NoteInitAll(void) {
 
         note->noteSubEu = gZeroNoteSub;
 
-        note->playbackState.priority = 0;
+        Audio_SetNotePriority(note, 0);
         note->playbackState.unk_04 = 0;
         note->playbackState.parentLayer = NO_LAYER;
         note->playbackState.wantedParentLayer = NO_LAYER;
@@ -864,6 +1036,7 @@ void Audio_NoteInitAll(void) {
         note->playbackState.portamento.cur = 0.0f;
         note->playbackState.portamento.speed = 0.0f;
 
-        note->synthesisState.synthesisBuffers = AudioHeap_Alloc(&gMiscPool, sizeof(Note));
+        // @port: Sized by what it holds, the buffers outgrew sizeof(Note) on some targets
+        note->synthesisState.synthesisBuffers = AudioHeap_Alloc(&gMiscPool, sizeof(NoteSynthesisBuffers));
     }
 }
@@ -274,6 +274,10 @@ void AudioSeq_AudioListPushBack(AudioListItem* list, AudioListItem* item) {
         list->prev = item;
         list->u.count++;
         item->pool = list->pool;
+        // @port: Note lists are indexed by priority
+        if (list->pool != NULL) {
+            Audio_SetNoteList(item->u.value, list);
+        }
     }
 }
 
@@ -287,6 +291,10 @@ void* AudioSeq_AudioListPopBack(AudioListItem* list) {
     list->prev = item->prev;
     item->prev = NULL;
     list->u.count--;
+    // @port: Note lists are indexed by priority
+    if (list->pool != NULL) {
+        Audio_SetNoteList(item->u.value, NULL);
+    }
     return item->u.value;
 }
 
@@ -1253,6 +1261,11 @@ void AudioSeq_SequencePlayerProcessSequence(SequencePlayer* seqPlayer) {
         return;
     }
 
+    // @port: A sequence whose fonts are still loading in the background waits for them instead of being disabled
+    if (!AudioLoad_SeqFontsLoaded(seqPlayer->seqId)) {
+        return;
+    }
+
     if (((gSeqLoadStatus[seqPlayer->seqId] < 2) != 0) ||
         ((seqPlayer->defaultFont != 0xFF) && ((gFontLoadStatus[seqPlayer->defaultFont] < 2) != 0))) {
         AudioSeq_SequencePlayerDisable(seqPlayer);
@@ -3,6 +3,10 @@
 #include "audio/mixer.h"
 #include "endianness.h"
 #include "port/Engine.h"
+#include "port/audio/ParallelSynthesis.h"
+#include "port/audio/SampleCache.h"
+
+static CVarHandle sSubwooferThresholdCVar = NULL;
 
 #define DMEM_WET_SCRATCH 0x470
 #define DMEM_COMPRESSED_ADPCM_DATA 0xD50
@@ -87,15 +91,17 @@ void AudioSynth_InitNextRingBuf(s32 sampleCount, s32 itemIndex, s32 reverbIndex)
     if ((reverb->downsampleRate != 1) && (reverb->framesToIgnore == 0)) {
         ringItem = &reverb->items[reverb->curFrame][itemIndex];
         osInvalDCache(ringItem->toDownsampleLeft, DMEM_1CH_SIZE * MAX_NUM_AUDIO_CHANNELS);
-        j = 0;
-        for (i = 0; i < ringItem->lengthA / 2; i++, j += reverb->downsampleRate) {
-            reverb->leftRingBuf[ringItem->startPos + i] = ringItem->toDownsampleLeft[j];
-            reverb->rightRingBuf[ringItem->startPos + i] = ringItem->toDownsampleRight[j];
-        }
-        for (i = 0; i < ringItem->lengthB / 2; i++, j += reverb->downsampleRate) {
-            reverb->leftRingBuf[i] = ringItem->toDownsampleLeft[j];
-            reverb->rightRingBuf[i] = ringItem->toDownsampleRight[j];
-        }
+        // @port: Downsample with the mixer's kernels
+        i = ringItem->lengthA / 2;
+        j = i * reverb->downsampleRate;
+        Mixer_Downsample(&reverb->leftRingBuf[ringItem->startPos], ringItem->toDownsampleLeft, i,
+                         reverb->downsampleRate);
+        Mixer_Downsample(&reverb->rightRingBuf[ringItem->startPos], ringItem->toDownsampleRight, i,
+                         reverb->downsampleRate);
+        Mixer_Downsample(reverb->leftRingBuf, &ringItem->toDownsampleLeft[j], ringItem->lengthB / 2,
+                         reverb->downsampleRate);
+        Mixer_Downsample(reverb->rightRingBuf, &ringItem->toDownsampleRight[j], ringItem->lengthB / 2,
+                         reverb->downsampleRate);
     }
 
     ringItem = &reverb->items[reverb->curFrame][itemIndex];
@@ -808,6 +814,9 @@ Acmd* AudioSynth_DoOneAudioUpdate(s16* aiBuf, s32 aiBufLen, Acmd* aList, s32 upd
         }
     }
 
+    // @port: Synthesize the notes that allow it on worker threads, they are mixed in below in note order
+    ParallelSynthesis_Process(sp84, count, aiBufLen, updateIndex);
+
     aClearBuffer(aList++, DMEM_LEFT_CH, DMEM_6CH_SIZE);
 
     j = 0;
@@ -820,8 +829,10 @@ Acmd* AudioSynth_DoOneAudioUpdate(s16* aiBuf, s32 aiBufLen, Acmd* aList, s32 upd
             if (i != gNoteSubsEu[updateIndex * gNumNotes + sp84[j]].bitField1.reverbIndex) {
                 break;
             }
-            aList = AudioSynth_ProcessNote(sp84[j], &gNoteSubsEu[updateIndex * gNumNotes + sp84[j]],
-                                           &gNotes[sp84[j]].synthesisState, aiBuf, aiBufLen, aList, updateIndex);
+            if (!ParallelSynthesis_Commit(sp84[j])) {
+                aList = AudioSynth_ProcessNote(sp84[j], &gNoteSubsEu[updateIndex * gNumNotes + sp84[j]],
+                                               &gNotes[sp84[j]].synthesisState, aiBuf, aiBufLen, aList, updateIndex);
+            }
             j++;
         }
         if (gSynthReverbs[i].useReverb) {
@@ -830,8 +841,10 @@ Acmd* AudioSynth_DoOneAudioUpdate(s16* aiBuf, s32 aiBufLen, Acmd* aList, s32 upd
     }
 
     while (j < count) {
-        aList = AudioSynth_ProcessNote(sp84[j], &gNoteSubsEu[updateIndex * gNumNotes + sp84[j]],
-                                       &gNotes[sp84[j]].synthesisState, aiBuf, aiBufLen, aList, updateIndex);
+        if (!ParallelSynthesis_Commit(sp84[j])) {
+            aList = AudioSynth_ProcessNote(sp84[j], &gNoteSubsEu[updateIndex * gNumNotes + sp84[j]],
+                                           &gNotes[sp84[j]].synthesisState, aiBuf, aiBufLen, aList, updateIndex);
+        }
         j++;
     }
 
@@ -847,6 +860,45 @@ Acmd* AudioSynth_DoOneAudioUpdate(s16* aiBuf, s32 aiBufLen, Acmd* aList, s32 upd
     return aList;
 }
 
+// @port: In-memory 16-bit samples are fetched through the sample DMA queue all notes share. Apart from that,
+// ProcessNote only touches the note itself and DMEM, so these notes can be synthesized on a mixer state of their own
+// off the audio thread, see ParallelSynthesis.cpp.
+bool AudioSynth_IsNoteIsolated(s32 noteIndex, s32 updateIndex) {
+    NoteSubEu* noteSub = &gNoteSubsEu[updateIndex * gNumNotes + noteIndex];
+
+    if (noteSub->bitField1.isSyntheticWave) {
+        return true;
+    }
+    return (*noteSub->waveSampleAddr)->codec != CODEC_S16_INMEMORY;
+}
+
+// @port: Resolves the CVars ProcessNote reads, so the worker threads only ever read them.
+void AudioSynth_ResolveNoteCVars(void) {
+    CVarGetCachedInteger(&sSubwooferThresholdCVar, "gSubwooferThreshold", 80);
+}
+
+// @port: Processes an isolated note into silent dry and wet channels of the calling thread's mixer state, and copies
+// them to dry and wet (DMEM_2CH_SIZE bytes each) for AudioSynth_MixIsolatedNote.
+void AudioSynth_ProcessIsolatedNote(s32 noteIndex, s32 aiBufLen, s32 updateIndex, s16* dry, s16* wet) {
+    // The commands run as they are issued, the list is only ever stepped through
+    Acmd cmd;
+    Acmd* aList = &cmd;
+
+    aClearBuffer(aList++, DMEM_LEFT_CH, DMEM_2CH_SIZE);
+    aClearBuffer(aList++, DMEM_WET_LEFT_CH, DMEM_2CH_SIZE);
+    aList = AudioSynth_ProcessNote(noteIndex, &gNoteSubsEu[updateIndex * gNumNotes + noteIndex],
+                                   &gNotes[noteIndex].synthesisState, NULL, aiBufLen, aList, updateIndex);
+    aSaveBuffer(aList++, DMEM_LEFT_CH, dry, DMEM_2CH_SIZE);
+    aSaveBuffer(aList++, DMEM_WET_LEFT_CH, wet, DMEM_2CH_SIZE);
+}
+
+// @port: Adds the channels of a note processed by AudioSynth_ProcessIsolatedNote to the output, like ProcessNote's
+// envelope mixer and Haas effect would have.
+void AudioSynth_MixIsolatedNote(const s16* dry, const s16* wet) {
+    Mixer_AddSamples(DMEM_LEFT_CH, dry, DMEM_2CH_SIZE);
+    Mixer_AddSamples(DMEM_WET_LEFT_CH, wet, DMEM_2CH_SIZE);
+}
+
 Acmd* AudioSynth_ProcessNote(s32 noteIndex, NoteSubEu* noteSub, NoteSynthesisState* synthState, s16* aiBuf,
                              s32 aiBufLen, Acmd* aList, s32 updateIndex) {
     s32 pad11C[3];
@@ -1102,7 +1154,12 @@ Acmd* AudioSynth_ProcessNote(s32 noteIndex, NoteSubEu* noteSub, NoteSynthesisSta
                         case 0:
                             aSetBuffer(aList++, 0, addr + sampleDataChunkAlignPad, DMEM_UNCOMPRESSED_NOTE,
                                        numSamplesToDecode * SAMPLE_SIZE);
-                            aADPCMdec(aList++, flags, OS_K0_TO_PHYSICAL(synthState->synthesisBuffers));
+                            // @port: Copy the frames from the decoded sample cache when it holds them
+                            if ((nFramesToDecode == 0) ||
+                                !SampleCache_DecodeADPCM(bookSample, currentBook, nEntries, frameIndex, flags,
+                                                         synthState->synthesisBuffers->adpcmdecState)) {
+                                aADPCMdec(aList++, flags, OS_K0_TO_PHYSICAL(synthState->synthesisBuffers));
+                            }
                             break;
 
                         case 1:
@@ -1119,7 +1176,12 @@ Acmd* AudioSynth_ProcessNote(s32 noteIndex, NoteSubEu* noteSub, NoteSynthesisSta
                         case 0:
                             aSetBuffer(aList++, 0, addr + sampleDataChunkAlignPad, DMEM_UNCOMPRESSED_NOTE + aligned,
                                        numSamplesToDecode * SAMPLE_SIZE);
-                            aADPCMdec(aList++, flags, OS_K0_TO_PHYSICAL(synthState->synthesisBuffers));
+                            // @port: Copy the frames from the decoded sample cache when it holds them
+                            if ((nFramesToDecode == 0) ||
+                                !SampleCache_DecodeADPCM(bookSample, currentBook, nEntries, frameIndex, flags,
+                                                         synthState->synthesisBuffers->adpcmdecState)) {
+                                aADPCMdec(aList++, flags, OS_K0_TO_PHYSICAL(synthState->synthesisBuffers));
+                            }
                             break;
 
                         case 1:
@@ -1354,7 +1416,7 @@ Acmd* AudioSynth_ProcessEnvelope(Acmd* aList, NoteSubEu* noteSub, NoteSynthesisS
     synthState->curVolLfe = curVolLfe + (rampLfe * aiBufLenSmall);
     synthState->curVolRLeft = curVolRLeft + (rampRLeft * aiBufLenSmall);
     synthState->curVolRRight = curVolRRight + (rampRRight * aiBufLenSmall);
-    uint32_t cutoffFreqLfe = CVarGetInteger("gSubwooferThreshold", 80);
+    uint32_t cutoffFreqLfe = CVarGetCachedInteger(&sSubwooferThresholdCVar, "gSubwooferThreshold", 80);
 
     if (noteSub->bitField0.usesHeadsetPanEffects) {
         int32_t num_audio_channels = 2;
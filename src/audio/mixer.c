@@ -1,30 +1,21 @@
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 
 #include <macros.h>
 
-#include "mixer.h"
+#include "mixer_internal.h"
 
 #ifndef __clang__
 #pragma GCC optimize("unroll-loops")
 #endif
 
-#if defined(__SSE2__) || defined(__aarch64__)
-#define SSE2_AVAILABLE
-#else
-#pragma message("Warning: SSE2 support is not available. Code will not compile")
-#endif
-
-#if defined(__SSE2__)
+#ifdef MIXER_SSE2
 #include <emmintrin.h>
-#elif defined(__aarch64__)
-#include "sse2neon.h"
-#endif
 
-#ifdef SSE2_AVAILABLE
 typedef struct {
     __m128i lo, hi;
 } m256i;
@@ -66,39 +57,27 @@ static __m128i m256i_clamp_to_m128i(m256i a) {
 }
 #endif
 
-#define ROUND_UP_64(v) (((v) + 63) & ~63)
-#define ROUND_UP_32(v) (((v) + 31) & ~31)
-#define ROUND_UP_16(v) (((v) + 15) & ~15)
-#define ROUND_UP_8(v) (((v) + 7) & ~7)
-#define ROUND_DOWN_16(v) ((v) & ~0xf)
-
-#define DMEM_BUF_SIZE (0x1B90) // 7056 B
-#define BUF_U8(a) (rspa.buf + ((a) -0x450))
-#define BUF_S16(a) (int16_t*) BUF_U8(a)
-
-#define SAMPLE_RATE 32000 // Adjusted to match the actual sample rate of 32 kHz
+static MixerState sAudioThreadState;
+uint32_t gMixerSampleRate = 32000;
+MIXER_THREAD_LOCAL MixerState* gMixerState = &sAudioThreadState;
 
-static struct {
-    uint16_t in;
-    uint16_t out;
-    uint16_t nbytes;
-
-    uint16_t vol[6];
-    uint16_t rate[6];
-    uint16_t vol_wet;
-    uint16_t rate_wet;
-
-    ADPCM_STATE* adpcm_loop_state;
+MixerState* Mixer_CreateState(void) {
+    return calloc(1, sizeof(MixerState));
+}
 
-    int16_t adpcm_table[8][2][8];
+void Mixer_DestroyState(MixerState* state) {
+    free(state);
+}
 
-    uint16_t filter_count;
-    int16_t filter[8];
+MixerState* Mixer_SetState(MixerState* state) {
+    MixerState* previous = gMixerState;
+    gMixerState = state != NULL ? state : &sAudioThreadState;
+    return previous;
+}
 
-    uint8_t buf[DMEM_BUF_SIZE];
-} rspa;
+static const MixerKernels* sMixerKernels = NULL;
 
-static int16_t resample_table[64][4] = {
+int16_t resample_table[64][4] = {
     { 0x0c39, 0x66ad, 0x0d46, 0xffdf }, { 0x0b39, 0x6696, 0x0e5f, 0xffd8 }, { 0x0a44, 0x6669, 0x0f83, 0xffd0 },
     { 0x095a, 0x6626, 0x10b4, 0xffc8 }, { 0x087d, 0x65cd, 0x11f0, 0xffbf }, { 0x07ab, 0x655e, 0x1338, 0xffb6 },
     { 0x06e4, 0x64d9, 0x148c, 0xffac }, { 0x0628, 0x643f, 0x15eb, 0xffa1 }, { 0x0577, 0x638f, 0x1756, 0xff96 },
@@ -123,15 +102,6 @@ static int16_t resample_table[64][4] = {
     { 0xffdf, 0x0d46, 0x66ad, 0x0c39 }
 };
 
-static inline int16_t clamp16(int32_t v) {
-    if (v < -0x8000) {
-        return -0x8000;
-    } else if (v > 0x7fff) {
-        return 0x7fff;
-    }
-    return (int16_t) v;
-}
-
 static inline int32_t clamp32(int64_t v) {
     if (v < -0x7fffffff - 1) {
         return -0x7fffffff - 1;
@@ -172,17 +142,10 @@ void aSetBufferImpl(uint8_t flags, uint16_t in, uint16_t out, uint16_t nbytes) {
     rspa.nbytes = nbytes;
 }
 
-void aInterleaveImpl(uint16_t left, uint16_t right, uint16_t center, uint16_t lfe, uint16_t surround_left,
-                     uint16_t surround_right, uint16_t num_channels) {
-    if (rspa.nbytes == 0) {
-        return;
-    }
-
-    int count = rspa.nbytes / (num_channels * sizeof(int16_t));
-
-    int16_t* l = BUF_S16(left);
-    int16_t* r = BUF_S16(right);
-    int16_t* d = BUF_S16(rspa.out);
+static void aInterleaveScalar(int16_t* out, const int16_t* channels[6], int count, uint16_t num_channels) {
+    const int16_t* l = channels[0];
+    const int16_t* r = channels[1];
+    int16_t* d = out;
 
     if (num_channels == 2) {
         for (int i = 0; i < count; i++) {
@@ -190,10 +153,10 @@ void aInterleaveImpl(uint16_t left, uint16_t right, uint16_t center, uint16_t lf
             *d++ = *r++;
         }
     } else {
-        int16_t* c = BUF_S16(center);
-        int16_t* lf = BUF_S16(lfe);
-        int16_t* sl = BUF_S16(surround_left);
-        int16_t* sr = BUF_S16(surround_right);
+        const int16_t* c = channels[2];
+        const int16_t* lf = channels[3];
+        const int16_t* sl = channels[4];
+        const int16_t* sr = channels[5];
 
         for (int i = 0; i < count; i++) {
             *d++ = *l++;
@@ -206,6 +169,12 @@ void aInterleaveImpl(uint16_t left, uint16_t right, uint16_t center, uint16_t lf
     }
 }
 
+static void aDownsampleScalar(int16_t* out, const int16_t* in, int count, int step) {
+    for (int i = 0; i < count; i++) {
+        out[i] = in[i * step];
+    }
+}
+
 void aDMEMMoveImpl(uint16_t in_addr, uint16_t out_addr, int nbytes) {
     nbytes = ROUND_UP_16(nbytes);
     memmove(BUF_U8(out_addr), BUF_U8(in_addr), nbytes);
@@ -215,19 +184,11 @@ void aSetLoopImpl(ADPCM_STATE* adpcm_loop_state) {
     rspa.adpcm_loop_state = adpcm_loop_state;
 }
 
-#ifndef SSE2_AVAILABLE
-
-void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
+static void aADPCMdecScalar(uint8_t flags, ADPCM_STATE state) {
     uint8_t* in = BUF_U8(rspa.in);
     int16_t* out = BUF_S16(rspa.out);
     int nbytes = ROUND_UP_32(rspa.nbytes);
-    if (flags & A_INIT) {
-        memset(out, 0, 16 * sizeof(int16_t));
-    } else if (flags & A_LOOP) {
-        memcpy(out, rspa.adpcm_loop_state, 16 * sizeof(int16_t));
-    } else {
-        memcpy(out, state, 16 * sizeof(int16_t));
-    }
+    Mixer_LoadDecodeState(flags, state, out);
     out += 16;
 
     while (nbytes > 0) {
@@ -268,7 +229,7 @@ void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
     memcpy(state, out - 16, 16 * sizeof(int16_t));
 }
 
-#else
+#ifdef MIXER_SSE2
 
 static uint16_t lower_4bit[] = {
     0xf,
@@ -277,26 +238,15 @@ static uint16_t lower_4bit[] = {
     0xf,
 };
 
-static uint16_t lower_2bit[] = {
-    0x3,
-    0x3,
-};
-
-void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
+static void aADPCMdecSSE2(uint8_t flags, ADPCM_STATE state) {
     uint8_t* in = BUF_U8(rspa.in);
     int16_t* out = BUF_S16(rspa.out);
     int nbytes = ROUND_UP_32(rspa.nbytes);
-    if (flags & A_INIT) {
-        memset(out, 0, 16 * sizeof(int16_t));
-    } else if (flags & A_LOOP) {
-        memcpy(out, rspa.adpcm_loop_state, 16 * sizeof(int16_t));
-    } else {
-        memcpy(out, state, 16 * sizeof(int16_t));
-    }
+    Mixer_LoadDecodeState(flags, state, out);
     out += 16;
 
     __m128i mask_4bit = _mm_loadl_epi64((__m128i*) lower_4bit);
-    __m128i mask_2bit = _mm_loadl_epi64((__m128i*) lower_2bit);
+    __m128i shift_2bit = _mm_setr_epi16(1 << 8, 1 << 10, 1 << 12, 1 << 14, 1 << 8, 1 << 10, 1 << 12, 1 << 14);
 
     while (nbytes > 0) {
         int shift = *in >> 4; // should be in 0..12 or 0..14
@@ -313,19 +263,14 @@ void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
 
             __m128i ins_vec;
             if (flags & 4) {
-                ins_vec = _mm_loadu_si16((__m128i*) in);
-                ins_vec = _mm_unpacklo_epi8(ins_vec, _mm_setzero_si128());
-                __m128i in_vec_up2bit = _mm_srli_epi16(ins_vec, 6);
-                __m128i in_vec_uplower2bit = _mm_and_si128(_mm_srli_epi16(ins_vec, 4), mask_2bit);
-                __m128i in_vec_lowerup2bit = _mm_and_si128(_mm_srli_epi16(ins_vec, 2), mask_2bit);
-                __m128i in_vec_lower2bit = _mm_and_si128(ins_vec, mask_2bit);
-                __m128i in_vec_up = _mm_unpacklo_epi16(in_vec_up2bit, in_vec_uplower2bit);
-                in_vec_up = _mm_shuffle_epi32(in_vec_up, _MM_SHUFFLE(3, 1, 2, 0));
-                __m128i in_vec_low = _mm_unpacklo_epi16(in_vec_lower2bit, in_vec_lowerup2bit);
-                in_vec_low = _mm_shuffle_epi32(in_vec_low, _MM_SHUFFLE(3, 1, 2, 0));
-                ins_vec = _mm_unpacklo_epi32(in_vec_up, in_vec_low);
-                ins_vec = _mm_slli_epi16(ins_vec, 14);
-                ins_vec = _mm_srai_epi16(ins_vec, 14);
+                // Every byte holds four 2-bit samples, highest bits first. Each sample is moved to the top of its
+                // own lane and shifted back down with its sign.
+                uint16_t bytes;
+                memcpy(&bytes, in, sizeof(bytes));
+                ins_vec = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128());
+                ins_vec = _mm_unpacklo_epi16(ins_vec, ins_vec);
+                ins_vec = _mm_unpacklo_epi32(ins_vec, ins_vec);
+                ins_vec = _mm_srai_epi16(_mm_mullo_epi16(ins_vec, shift_2bit), 14);
                 ins_vec = _mm_slli_epi16(ins_vec, shift);
 
                 in += 2;
@@ -393,31 +338,15 @@ void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
 
 #endif
 
-#ifndef SSE2_AVAILABLE
-
-void aResampleImpl(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
-    int16_t tmp[16];
+static void aResampleScalar(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
     int16_t* in_initial = BUF_S16(rspa.in);
-    int16_t* in = in_initial;
     int16_t* out = BUF_S16(rspa.out);
     int nbytes = ROUND_UP_16(rspa.nbytes);
     uint32_t pitch_accumulator;
     int i;
     int16_t* tbl;
     int32_t sample;
-
-    if (flags & A_INIT) {
-        memset(tmp, 0, 5 * sizeof(int16_t));
-    } else {
-        memcpy(tmp, state, 16 * sizeof(int16_t));
-    }
-    if (flags & 2) {
-        memcpy(in - 8, tmp + 8, 8 * sizeof(int16_t));
-        in -= tmp[5] / sizeof(int16_t);
-    }
-    in -= 4;
-    pitch_accumulator = (uint16_t) tmp[4];
-    memcpy(in, tmp, 4 * sizeof(int16_t));
+    int16_t* in = Mixer_BeginResample(flags, state, in_initial, &pitch_accumulator);
 
     do {
         for (i = 0; i < 8; i++) {
@@ -433,18 +362,10 @@ void aResampleImpl(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
         nbytes -= 8 * sizeof(int16_t);
     } while (nbytes > 0);
 
-    state[4] = (int16_t) pitch_accumulator;
-    memcpy(state, in, 4 * sizeof(int16_t));
-    i = (in - in_initial + 4) & 7;
-    in -= i;
-    if (i != 0) {
-        i = -8 - i;
-    }
-    state[5] = i;
-    memcpy(state + 8, in, 8 * sizeof(int16_t));
+    Mixer_EndResample(state, in, in_initial, pitch_accumulator);
 }
 
-#else
+#ifdef MIXER_SSE2
 
 static const ALIGN_ASSET(16) int32_t x4000[4] = {
     0x4000,
@@ -483,27 +404,13 @@ static __m128i move_two_4x16(int16_t* a, int16_t* b) {
                          _mm_movepi64_pi64(_mm_loadl_epi64((__m128i*) b)));
 }
 
-void aResampleImpl(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
-    int16_t tmp[32];
+static void aResampleSSE2(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
     int16_t* in_initial = BUF_S16(rspa.in);
-    int16_t* in = in_initial;
     int16_t* out = BUF_S16(rspa.out);
     int nbytes = ROUND_UP_16(rspa.nbytes);
     uint32_t pitch_accumulator;
     int i;
-
-    if (flags & A_INIT) {
-        memset(tmp, 0, 5 * sizeof(int16_t));
-    } else {
-        memcpy(tmp, state, 16 * sizeof(int16_t));
-    }
-    if (flags & 2) {
-        memcpy(in - 8, tmp + 8, 8 * sizeof(int16_t));
-        in -= tmp[5] / sizeof(int16_t);
-    }
-    in -= 4;
-    pitch_accumulator = (uint16_t) tmp[4];
-    memcpy(in, tmp, 4 * sizeof(int16_t));
+    int16_t* in = Mixer_BeginResample(flags, state, in_initial, &pitch_accumulator);
 
     __m128i x4000Vec = _mm_load_si128((__m128i*) x4000);
 
@@ -596,15 +503,7 @@ void aResampleImpl(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
         nbytes -= 8 * sizeof(int16_t);
     } while (nbytes > 0);
 
-    state[4] = (int16_t) pitch_accumulator;
-    memcpy(state, in, 4 * sizeof(int16_t));
-    i = (in - in_initial + 4) & 7;
-    in -= i;
-    if (i != 0) {
-        i = -8 - i;
-    }
-    state[5] = i;
-    memcpy(state + 8, in, 8 * sizeof(int16_t));
+    Mixer_EndResample(state, in, in_initial, pitch_accumulator);
 }
 
 #endif
@@ -631,8 +530,9 @@ void aEnvSetup2Impl(uint16_t initial_vol_left, uint16_t initial_vol_right, int16
     rspa.vol[5] = initial_vol_rear_right;
 }
 
-void aEnvMixerImpl(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left, bool neg_right,
-                   uint32_t wet_dry_addr, uint32_t haas_temp_addr, uint32_t num_channels, uint32_t cutoff_freq_lfe) {
+static void aEnvMixerScalar(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left, bool neg_right,
+                            uint32_t wet_dry_addr, uint32_t haas_temp_addr, uint32_t num_channels,
+                            uint32_t cutoff_freq_lfe) {
     // Note: max number of samples is 192 (192 * 2 = 384 bytes = 0x180)
     int max_num_samples = 192;
 
@@ -661,12 +561,7 @@ void aEnvMixerImpl(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool
 
     if (num_channels == 6) {
         // Calculate the filter coefficient
-        float RC = 1.f / (2 * M_PI * cutoff_freq_lfe);
-        float dt = 1.f / SAMPLE_RATE;
-        float alpha = dt / (RC + dt);
-
-        // Low-pass filter state for the subwoofer channel
-        static float prev_lfe_sample = 0.0f;
+        float alpha = Mixer_LfeAlpha(cutoff_freq_lfe);
 
         for (int i = 0; i < n / 8; i++) {
             for (int k = 0; k < 8; k++) {
@@ -686,10 +581,7 @@ void aEnvMixerImpl(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool
                 }
 
                 // Apply low-pass filter to the LFE channel (index 3)
-                float lfe_sample = samples[3];
-                lfe_sample = alpha * lfe_sample + (1.0f - alpha) * prev_lfe_sample;
-                prev_lfe_sample = lfe_sample;
-                samples[3] = (int16_t) lfe_sample;
+                samples[3] = Mixer_FilterLfe(samples[3], alpha);
 
                 // Mix dry and wet signals
                 for (int j = 0; j < 6; j++) {
@@ -755,9 +647,7 @@ void aEnvMixerImpl(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool
     }
 }
 
-#ifndef SSE2_AVAILABLE
-
-void aMixImpl(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
+static void aMixScalar(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
     int nbytes = ROUND_UP_32(ROUND_DOWN_16(count << 4));
     int16_t* in = BUF_S16(in_addr);
     int16_t* out = BUF_S16(out_addr);
@@ -784,13 +674,13 @@ void aMixImpl(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr)
     }
 }
 
-#else
+#ifdef MIXER_SSE2
 
 static const ALIGN_ASSET(16) int16_t x7fff[8] = {
     0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF,
 };
 
-void aMixImpl(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
+static void aMixSSE2(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
     int nbytes = ROUND_UP_32(ROUND_DOWN_16(count << 4));
     int16_t* in = BUF_S16(in_addr);
     int16_t* out = BUF_S16(out_addr);
@@ -849,17 +739,11 @@ void aMixImpl(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr)
 
 #endif
 
-void aS8DecImpl(uint8_t flags, ADPCM_STATE state) {
+static void aS8DecScalar(uint8_t flags, ADPCM_STATE state) {
     uint8_t* in = BUF_U8(rspa.in);
     int16_t* out = BUF_S16(rspa.out);
     int nbytes = ROUND_UP_32(rspa.nbytes);
-    if (flags & A_INIT) {
-        memset(out, 0, 16 * sizeof(int16_t));
-    } else if (flags & A_LOOP) {
-        memcpy(out, rspa.adpcm_loop_state, 16 * sizeof(int16_t));
-    } else {
-        memcpy(out, state, 16 * sizeof(int16_t));
-    }
+    Mixer_LoadDecodeState(flags, state, out);
     out += 16;
 
     while (nbytes > 0) {
@@ -886,7 +770,7 @@ void aS8DecImpl(uint8_t flags, ADPCM_STATE state) {
     memcpy(state, out - 16, 16 * sizeof(int16_t));
 }
 
-void aAddMixerImpl(uint16_t count, uint16_t in_addr, uint16_t out_addr) {
+static void aAddMixerScalar(uint16_t count, uint16_t in_addr, uint16_t out_addr) {
     int16_t* in = BUF_S16(in_addr);
     int16_t* out = BUF_S16(out_addr);
     int nbytes = ROUND_UP_64(ROUND_DOWN_16(count));
@@ -974,7 +858,7 @@ void aResampleZohImpl(uint16_t pitch, uint16_t start_fract) {
     } while (nbytes > 0);
 }
 
-void aInterlImpl(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
+static void aInterlScalar(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
     int16_t* in = BUF_S16(in_addr);
     int16_t* out = BUF_S16(out_addr);
     int n = ROUND_UP_8(n_samples);
@@ -1001,55 +885,50 @@ void aInterlImpl(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
     } while (n > 0);
 }
 
-void aFilterImpl(uint8_t flags, uint16_t count_or_buf, int16_t* state_or_filter) {
-    if (flags > A_INIT) {
-        rspa.filter_count = ROUND_UP_16(count_or_buf);
-        memcpy(rspa.filter, state_or_filter, sizeof(rspa.filter));
-    } else {
-        int16_t tmp[16], tmp2[8];
-        int count = rspa.filter_count;
-        int16_t* buf = BUF_S16(count_or_buf);
+static void aFilterScalar(uint8_t flags, uint16_t buf_addr, int16_t* state) {
+    int16_t tmp[16], tmp2[8];
+    int count = rspa.filter_count;
+    int16_t* buf = BUF_S16(buf_addr);
 
-        if (flags == A_INIT) {
+    if (flags == A_INIT) {
 #ifndef __clang__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmemset-elt-size"
 #endif
-            memset(tmp, 0, 8 * sizeof(int16_t));
+        memset(tmp, 0, 8 * sizeof(int16_t));
 #ifndef __clang__
 #pragma GCC diagnostic pop
 #endif
-            memset(tmp2, 0, 8 * sizeof(int16_t));
-        } else {
-            memcpy(tmp, state_or_filter, 8 * sizeof(int16_t));
-            memcpy(tmp2, state_or_filter + 8, 8 * sizeof(int16_t));
-        }
+        memset(tmp2, 0, 8 * sizeof(int16_t));
+    } else {
+        memcpy(tmp, state, 8 * sizeof(int16_t));
+        memcpy(tmp2, state + 8, 8 * sizeof(int16_t));
+    }
 
-        for (int i = 0; i < 8; i++) {
-            rspa.filter[i] = (tmp2[i] + rspa.filter[i]) / 2;
-        }
+    for (int i = 0; i < 8; i++) {
+        rspa.filter[i] = (tmp2[i] + rspa.filter[i]) / 2;
+    }
 
-        do {
-            memcpy(tmp + 8, buf, 8 * sizeof(int16_t));
-            for (int i = 0; i < 8; i++) {
-                int64_t sample = 0x4000; // round term
-                for (int j = 0; j < 8; j++) {
-                    sample += tmp[i + j] * rspa.filter[7 - j];
-                }
-                buf[i] = clamp16((int32_t) (sample >> 15));
+    do {
+        memcpy(tmp + 8, buf, 8 * sizeof(int16_t));
+        for (int i = 0; i < 8; i++) {
+            int64_t sample = 0x4000; // round term
+            for (int j = 0; j < 8; j++) {
+                sample += tmp[i + j] * rspa.filter[7 - j];
             }
-            memcpy(tmp, tmp + 8, 8 * sizeof(int16_t));
+            buf[i] = clamp16((int32_t) (sample >> 15));
+        }
+        memcpy(tmp, tmp + 8, 8 * sizeof(int16_t));
 
-            buf += 8;
-            count -= 8 * sizeof(int16_t);
-        } while (count > 0);
+        buf += 8;
+        count -= 8 * sizeof(int16_t);
+    } while (count > 0);
 
-        memcpy(state_or_filter, tmp, 8 * sizeof(int16_t));
-        memcpy(state_or_filter + 8, rspa.filter, 8 * sizeof(int16_t));
-    }
+    memcpy(state, tmp, 8 * sizeof(int16_t));
+    memcpy(state + 8, rspa.filter, 8 * sizeof(int16_t));
 }
 
-void aHiLoGainImpl(uint8_t g, uint16_t count, uint16_t addr) {
+static void aHiLoGainScalar(uint8_t g, uint16_t count, uint16_t addr) {
     int16_t* samples = BUF_S16(addr);
     int nbytes = ROUND_UP_32(count);
 
@@ -1093,3 +972,194 @@ void aUnkCmd19Impl(uint8_t f, uint16_t count, uint16_t out_addr, uint16_t in_add
         nbytes -= 32 * sizeof(int16_t);
     } while (nbytes > 0);
 }
+
+const MixerKernels gMixerKernelsScalar = {
+    "scalar",        aADPCMdecScalar, aResampleScalar, aEnvMixerScalar, aMixScalar,        aS8DecScalar,
+    aAddMixerScalar, aInterlScalar,   aFilterScalar,   aHiLoGainScalar, aInterleaveScalar, aDownsampleScalar,
+};
+
+#ifdef MIXER_SSE2
+// SSE2 only covers the commands that had it before the kernel sets, the rest stay scalar
+const MixerKernels gMixerKernelsSSE2 = {
+    "sse2",          aADPCMdecSSE2, aResampleSSE2, aEnvMixerScalar, aMixSSE2,          aS8DecScalar,
+    aAddMixerScalar, aInterlScalar, aFilterScalar, aHiLoGainScalar, aInterleaveScalar, aDownsampleScalar,
+};
+#endif
+
+uint32_t Mixer_GetAvailableKernels(const MixerKernels* sets[4]) {
+    uint32_t count = 0;
+
+    sets[count++] = &gMixerKernelsScalar;
+#ifdef MIXER_SSE2
+    sets[count++] = &gMixerKernelsSSE2;
+#endif
+#ifdef MIXER_AVX2
+    if (Mixer_CpuSupportsAVX2()) {
+        sets[count++] = &gMixerKernelsAVX2;
+    }
+#endif
+#ifdef MIXER_NEON
+    sets[count++] = &gMixerKernelsNEON;
+#endif
+    return count;
+}
+
+static const MixerKernels* Mixer_SelectKernels(void) {
+#ifdef MIXER_AVX2
+    if (Mixer_CpuSupportsAVX2()) {
+        return &gMixerKernelsAVX2;
+    }
+#endif
+#if defined(MIXER_NEON)
+    return &gMixerKernelsNEON;
+#elif defined(MIXER_SSE2)
+    return &gMixerKernelsSSE2;
+#else
+    return &gMixerKernelsScalar;
+#endif
+}
+
+void Mixer_Init(void) {
+    sMixerKernels = Mixer_SelectKernels();
+}
+
+// Set by Mixer_Init before any mixing, so threads mixing in parallel only ever read it
+static inline const MixerKernels* Mixer_GetKernels(void) {
+    return sMixerKernels;
+}
+
+const char* Mixer_GetKernelsName(void) {
+    return Mixer_GetKernels()->name;
+}
+
+void aADPCMdecImpl(uint8_t flags, ADPCM_STATE state) {
+    Mixer_GetKernels()->adpcmDec(flags, state);
+}
+
+void aResampleImpl(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
+    Mixer_GetKernels()->resample(flags, pitch, state);
+}
+
+void aEnvMixerImpl(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left, bool neg_right,
+                   uint32_t wet_dry_addr, uint32_t haas_temp_addr, uint32_t num_channels, uint32_t cutoff_freq_lfe) {
+    Mixer_GetKernels()->envMixer(in_addr, n_samples, swap_reverb, neg_left, neg_right, wet_dry_addr, haas_temp_addr,
+                                 num_channels, cutoff_freq_lfe);
+}
+
+void aMixImpl(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
+    Mixer_GetKernels()->mix(count, gain, in_addr, out_addr);
+}
+
+void aS8DecImpl(uint8_t flags, ADPCM_STATE state) {
+    Mixer_GetKernels()->s8Dec(flags, state);
+}
+
+void aAddMixerImpl(uint16_t count, uint16_t in_addr, uint16_t out_addr) {
+    Mixer_GetKernels()->addMixer(count, in_addr, out_addr);
+}
+
+void aInterlImpl(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
+    Mixer_GetKernels()->interl(in_addr, out_addr, n_samples);
+}
+
+void aFilterImpl(uint8_t flags, uint16_t count_or_buf, int16_t* state_or_filter) {
+    if (flags > A_INIT) {
+        rspa.filter_count = ROUND_UP_16(count_or_buf);
+        memcpy(rspa.filter, state_or_filter, sizeof(rspa.filter));
+    } else {
+        Mixer_GetKernels()->filter(flags, count_or_buf, state_or_filter);
+    }
+}
+
+void aHiLoGainImpl(uint8_t g, uint16_t count, uint16_t addr) {
+    Mixer_GetKernels()->hiLoGain(g, count, addr);
+}
+
+void aInterleaveImpl(uint16_t left, uint16_t right, uint16_t center, uint16_t lfe, uint16_t surround_left,
+                     uint16_t surround_right, uint16_t num_channels) {
+    if (rspa.nbytes == 0) {
+        return;
+    }
+
+    int count = rspa.nbytes / (num_channels * sizeof(int16_t));
+    const int16_t* channels[6] = { BUF_S16(left), BUF_S16(right) };
+    if (num_channels != 2) {
+        channels[2] = BUF_S16(center);
+        channels[3] = BUF_S16(lfe);
+        channels[4] = BUF_S16(surround_left);
+        channels[5] = BUF_S16(surround_right);
+    }
+
+    Mixer_GetKernels()->interleave(BUF_S16(rspa.out), channels, count, num_channels);
+}
+
+void Mixer_SetSampleRate(uint32_t rate) {
+    gMixerSampleRate = rate;
+}
+
+void Mixer_Downsample(int16_t* out, const int16_t* in, int count, int step) {
+    Mixer_GetKernels()->downsample(out, in, count, step);
+}
+
+void Mixer_AddSamples(uint16_t dest_addr, const int16_t* source, uint16_t nbytes) {
+    int16_t* out = BUF_S16(dest_addr);
+
+    for (int i = 0; i < nbytes / (int) sizeof(int16_t); i++) {
+        out[i] = clamp16(out[i] + source[i]);
+    }
+}
+
+// Frames decoded per run, sized to fit DMEM with the output after the input
+#define DECODE_CHUNK_FRAMES 64
+#define DECODE_IN 0x450
+#define DECODE_OUT (DECODE_IN + ROUND_UP_16(DECODE_CHUNK_FRAMES * 9))
+
+void Mixer_DecodeADPCM(const uint8_t* in, uint32_t num_frames, ADPCM_STATE state, int16_t* out) {
+    while (num_frames > 0) {
+        uint32_t frames = num_frames < DECODE_CHUNK_FRAMES ? num_frames : DECODE_CHUNK_FRAMES;
+
+        memcpy(BUF_U8(DECODE_IN), in, frames * 9);
+        rspa.in = DECODE_IN;
+        rspa.out = DECODE_OUT;
+        rspa.nbytes = frames * 16 * sizeof(int16_t);
+        Mixer_GetKernels()->adpcmDec(A_CONTINUE, state);
+        memcpy(out, BUF_S16(DECODE_OUT) + 16, frames * 16 * sizeof(int16_t));
+
+        in += frames * 9;
+        out += frames * 16;
+        num_frames -= frames;
+    }
+}
+
+bool Mixer_CopyDecodedADPCM(uint8_t flags, ADPCM_STATE state, const int16_t* decoded, uint32_t num_frames) {
+    uint32_t frames = ROUND_UP_32(rspa.nbytes) / (16 * sizeof(int16_t));
+    uint32_t out_end = rspa.out + (frames + 1) * 16 * sizeof(int16_t);
+    const int16_t* history;
+
+    if (flags & A_INIT) {
+        history = NULL;
+    } else if (flags & A_LOOP) {
+        history = *rspa.adpcm_loop_state;
+    } else {
+        history = state;
+    }
+
+    // Each frame only depends on its data and the last two samples before it
+    if (history != NULL ? (history[14] != decoded[14] || history[15] != decoded[15])
+                        : (decoded[14] != 0 || decoded[15] != 0)) {
+        return false;
+    }
+    if (frames > num_frames) {
+        return false;
+    }
+    // The decoder would overwrite data it hasn't read yet
+    if (out_end > rspa.in && rspa.out < rspa.in + frames * 9) {
+        return false;
+    }
+
+    int16_t* out = BUF_S16(rspa.out);
+    Mixer_LoadDecodeState(flags, state, out);
+    memcpy(out + 16, decoded + 16, frames * 16 * sizeof(int16_t));
+    memcpy(state, out + frames * 16, 16 * sizeof(int16_t));
+    return true;
+}
@@ -32,6 +32,8 @@
 #undef aUnkCmd3
 #undef aUnkCmd19
 
+typedef struct MixerState MixerState;
+
 void aClearBufferImpl(uint16_t addr, int nbytes);
 void aLoadBufferImpl(const void* source_addr, uint16_t dest_addr, uint16_t nbytes);
 void aSaveBufferImpl(uint16_t source_addr, int16_t* dest_addr, uint16_t nbytes);
@@ -60,6 +62,46 @@ void aHiLoGainImpl(uint8_t g, uint16_t count, uint16_t addr);
 void aUnkCmd3Impl(uint16_t a, uint16_t b, uint16_t c);
 void aUnkCmd19Impl(uint8_t f, uint16_t count, uint16_t out_addr, uint16_t in_addr);
 
+// States for running mixer commands off the audio thread. The commands a thread issues work on the state set for it,
+// NULL sets the audio thread's state again. Mixer_SetState returns the state that was set before.
+MixerState* Mixer_CreateState(void);
+void Mixer_DestroyState(MixerState* state);
+MixerState* Mixer_SetState(MixerState* state);
+
+// Sets the rate the mixed output plays at, which the subwoofer's low-pass is tuned to
+void Mixer_SetSampleRate(uint32_t rate);
+
+// Copies every step-th of count * step samples from in to out
+void Mixer_Downsample(int16_t* out, const int16_t* in, int count, int step);
+
+// Adds nbytes of samples from source to the DMEM buffer at dest_addr, clamping like aAddMixer
+void Mixer_AddSamples(uint16_t dest_addr, const int16_t* source, uint16_t nbytes);
+
+// Decodes num_frames frames of ADPCM data with the book loaded by aLoadADPCM, continuing from the 16 samples in
+// state like aADPCMdec does, and writes the 16 samples of each frame to out. state holds the last frame afterwards.
+void Mixer_DecodeADPCM(const uint8_t* in, uint32_t num_frames, ADPCM_STATE state, int16_t* out);
+
+// Does what aADPCMdec would with the current buffers, from frames decoded ahead of time. decoded holds the frame the
+// decoder continues from followed by num_frames decoded frames. Returns false without touching anything when the
+// decoder would continue from other samples or needs more frames, the data then has to be decoded.
+bool Mixer_CopyDecodedADPCM(uint8_t flags, ADPCM_STATE state, const int16_t* decoded, uint32_t num_frames);
+
+// Picks the kernel set the mixer commands run on for the CPU. Called once at audio init, before anything is mixed.
+void Mixer_Init(void);
+
+// Name of the kernel set the mixer commands run on
+const char* Mixer_GetKernelsName(void);
+
+// Runs every SIMD kernel set the CPU supports against the scalar one on random input, passing a line per kernel
+// to report. Returns the number of mismatching runs.
+uint32_t Mixer_VerifyKernels(uint32_t iterations, uint32_t seed, void (*report)(void* user_data, const char* line),
+                             void* user_data);
+
+// Times the envelope mixer and interleave of an audio update with every kernel set the CPU supports, passing a line
+// per set to report. now returns the current time in seconds.
+void Mixer_BenchmarkKernels(uint32_t notes, uint32_t updates, uint32_t num_channels, double (*now)(void),
+                            void (*report)(void* user_data, const char* line), void* user_data);
+
 #define aSegment(pkt, s, b) \
     do {                    \
     } while (0)
@@ -0,0 +1,573 @@
+#include <stdio.h>
+
+#include "mixer_internal.h"
+
+#ifdef MIXER_AVX2
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts AVX2 intrinsics anywhere
+#define AVX2_TARGET
+#else
+// Compiled for the baseline target, only ever called after Mixer_CpuSupportsAVX2
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+bool Mixer_CpuSupportsAVX2(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // The OS has to save the YMM registers too
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// (a * b) >> 16 with a signed and b unsigned, truncated to 16 bits
+AVX2_TARGET static inline __m256i MulHiSignedUnsigned(__m256i a, __m256i b) {
+    return _mm256_add_epi16(_mm256_mulhi_epi16(a, b), _mm256_and_si256(a, _mm256_srai_epi16(b, 15)));
+}
+
+AVX2_TARGET static inline __m128i MulHiSignedUnsigned128(__m128i a, __m128i b) {
+    return _mm_add_epi16(_mm_mulhi_epi16(a, b), _mm_and_si128(a, _mm_srai_epi16(b, 15)));
+}
+
+// Two rows of four samples from each of a, b in the low lane and c, d in the high lane
+AVX2_TARGET static inline __m256i LoadFourByFour(const int16_t* a, const int16_t* b, const int16_t* c,
+                                                 const int16_t* d) {
+    __m128i lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) a), _mm_loadl_epi64((const __m128i*) b));
+    __m128i hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) c), _mm_loadl_epi64((const __m128i*) d));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+AVX2_TARGET static inline __m128i PackToInt16(__m256i v) {
+    return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+AVX2_TARGET static void aADPCMdecAVX2(uint8_t flags, ADPCM_STATE state) {
+    uint8_t* in = BUF_U8(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_32(rspa.nbytes);
+    Mixer_LoadDecodeState(flags, state, out);
+    out += 16;
+
+    const __m128i mask_4bit = _mm_set1_epi16(0xf);
+    const __m128i shift_2bit = _mm_setr_epi16(1 << 8, 1 << 10, 1 << 12, 1 << 14, 1 << 8, 1 << 10, 1 << 12, 1 << 14);
+
+    while (nbytes > 0) {
+        int shift = *in >> 4;          // should be in 0..12 or 0..14
+        int table_index = *in++ & 0xf; // should be in 0..7
+        int16_t(*tbl)[8] = rspa.adpcm_table[table_index];
+        __m128i shift_count = _mm_cvtsi32_si128(shift);
+
+        // Each of the 8 outputs also adds tbl[1][j - k - 1] * ins[k] for every earlier input k of its group.
+        // Loading tbl[1] from behind 8 zeros gives those coefficients as one column per k.
+        int16_t padded[16] = { 0 };
+        memcpy(padded + 8, tbl[1], 8 * sizeof(int16_t));
+        __m256i columns[7];
+        for (int k = 0; k < 7; k++) {
+            columns[k] = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*) (padded + 7 - k)));
+        }
+        __m256i tbl0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*) tbl[0]));
+        __m256i tbl1 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*) tbl[1]));
+
+        for (int i = 0; i < 2; i++) {
+            __m128i ins_vec;
+            if (flags & 4) {
+                // Every byte holds four 2-bit samples, highest bits first. Each sample is moved to the top of its
+                // own lane and shifted back down with its sign.
+                uint16_t bytes;
+                memcpy(&bytes, in, sizeof(bytes));
+                ins_vec = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128());
+                ins_vec = _mm_unpacklo_epi16(ins_vec, ins_vec);
+                ins_vec = _mm_unpacklo_epi32(ins_vec, ins_vec);
+                ins_vec = _mm_srai_epi16(_mm_mullo_epi16(ins_vec, shift_2bit), 14);
+                in += 2;
+            } else {
+                uint32_t bytes;
+                memcpy(&bytes, in, sizeof(bytes));
+                ins_vec = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128());
+                ins_vec = _mm_unpacklo_epi16(_mm_srli_epi16(ins_vec, 4), _mm_and_si128(ins_vec, mask_4bit));
+                ins_vec = _mm_srai_epi16(_mm_slli_epi16(ins_vec, 12), 12);
+                in += 4;
+            }
+            ins_vec = _mm_sll_epi16(ins_vec, shift_count);
+
+            int16_t ins[8];
+            _mm_storeu_si128((__m128i*) ins, ins_vec);
+
+            __m256i acc = _mm256_add_epi32(_mm256_mullo_epi32(tbl0, _mm256_set1_epi32(out[-2])),
+                                           _mm256_mullo_epi32(tbl1, _mm256_set1_epi32(out[-1])));
+            acc = _mm256_add_epi32(acc, _mm256_slli_epi32(_mm256_cvtepi16_epi32(ins_vec), 11));
+            for (int k = 0; k < 7; k++) {
+                acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(columns[k], _mm256_set1_epi32(ins[k])));
+            }
+
+            _mm_storeu_si128((__m128i*) out, PackToInt16(_mm256_srai_epi32(acc, 11)));
+            out += 8;
+        }
+        nbytes -= 16 * sizeof(int16_t);
+    }
+    memcpy(state, out - 16, 16 * sizeof(int16_t));
+}
+
+AVX2_TARGET static void aResampleAVX2(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
+    int16_t* in_initial = BUF_S16(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_16(rspa.nbytes);
+    uint32_t pitch_accumulator;
+    int16_t* in = Mixer_BeginResample(flags, state, in_initial, &pitch_accumulator);
+
+    const __m256i round = _mm256_set1_epi32(0x4000);
+
+    do {
+        int16_t* ins[8];
+        int16_t* tbls[8];
+        for (int i = 0; i < 8; i++) {
+            tbls[i] = resample_table[pitch_accumulator * 64 >> 16];
+            ins[i] = in;
+
+            pitch_accumulator += (pitch << 1);
+            in += pitch_accumulator >> 16;
+            pitch_accumulator %= 0x10000;
+        }
+
+        // Outputs 0, 1 | 4, 5 and 2, 3 | 6, 7, so the sums below come out in order within each lane
+        __m256i in_a = LoadFourByFour(ins[0], ins[1], ins[4], ins[5]);
+        __m256i in_b = LoadFourByFour(ins[2], ins[3], ins[6], ins[7]);
+        __m256i tbl_a = LoadFourByFour(tbls[0], tbls[1], tbls[4], tbls[5]);
+        __m256i tbl_b = LoadFourByFour(tbls[2], tbls[3], tbls[6], tbls[7]);
+
+        __m256i lo = _mm256_mullo_epi16(in_a, tbl_a);
+        __m256i hi = _mm256_mulhi_epi16(in_a, tbl_a);
+        __m256i terms0 = _mm256_unpacklo_epi16(lo, hi); // outputs 0 | 4
+        __m256i terms1 = _mm256_unpackhi_epi16(lo, hi); // outputs 1 | 5
+        lo = _mm256_mullo_epi16(in_b, tbl_b);
+        hi = _mm256_mulhi_epi16(in_b, tbl_b);
+        __m256i terms2 = _mm256_unpacklo_epi16(lo, hi); // outputs 2 | 6
+        __m256i terms3 = _mm256_unpackhi_epi16(lo, hi); // outputs 3 | 7
+
+        // Every product is rounded on its own before the four are added, like the reference
+        terms0 = _mm256_srai_epi32(_mm256_add_epi32(terms0, round), 15);
+        terms1 = _mm256_srai_epi32(_mm256_add_epi32(terms1, round), 15);
+        terms2 = _mm256_srai_epi32(_mm256_add_epi32(terms2, round), 15);
+        terms3 = _mm256_srai_epi32(_mm256_add_epi32(terms3, round), 15);
+
+        __m256i sums = _mm256_hadd_epi32(_mm256_hadd_epi32(terms0, terms1), _mm256_hadd_epi32(terms2, terms3));
+        __m256i packed = _mm256_packs_epi32(sums, sums);
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128((__m128i*) out, _mm256_castsi256_si128(packed));
+        out += 8;
+
+        nbytes -= 8 * sizeof(int16_t);
+    } while (nbytes > 0);
+
+    Mixer_EndResample(state, in, in_initial, pitch_accumulator);
+}
+
+// Runs the 8 or 16 subwoofer samples of v through the low-pass, in order
+AVX2_TARGET static inline __m256i FilterLfe(__m256i v, int count, float alpha) {
+    int16_t samples[16];
+    _mm256_storeu_si256((__m256i*) samples, v);
+    for (int k = 0; k < count; k++) {
+        samples[k] = Mixer_FilterLfe(samples[k], alpha);
+    }
+    return _mm256_loadu_si256((__m256i*) samples);
+}
+
+AVX2_TARGET static void aEnvMixerAVX2(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left,
+                                      bool neg_right, uint32_t wet_dry_addr, uint32_t haas_temp_addr,
+                                      uint32_t num_channels, uint32_t cutoff_freq_lfe) {
+    int max_num_samples = 192;
+
+    int16_t* in = BUF_S16(in_addr);
+    int n = ROUND_UP_16(n_samples);
+    if (n > max_num_samples) {
+        printf("Warning: n_samples is too large: %d\n", n_samples);
+    }
+
+    int dry_addr_start = wet_dry_addr & 0xFFFF;
+    int wet_addr_start = wet_dry_addr >> 16;
+
+    // Only the front channels get reverb
+    int16_t* dry[6];
+    int16_t* wet[2];
+    for (int i = 0; i < 6; i++) {
+        dry[i] = BUF_S16(dry_addr_start + max_num_samples * i * sizeof(int16_t));
+    }
+    for (int i = 0; i < 2; i++) {
+        wet[i] = BUF_S16(wet_addr_start + max_num_samples * i * sizeof(int16_t));
+    }
+
+    uint16_t vols[6] = { rspa.vol[0], rspa.vol[1], rspa.vol[2], rspa.vol[3], rspa.vol[4], rspa.vol[5] };
+    uint16_t vol_wet = rspa.vol_wet;
+    __m256i negs[6];
+    for (int i = 0; i < 6; i++) {
+        negs[i] = _mm256_set1_epi16(-1);
+    }
+    float alpha = 0.0f;
+    int num_dry;
+
+    if (num_channels == 6) {
+        num_dry = 6;
+        alpha = Mixer_LfeAlpha(cutoff_freq_lfe);
+    } else {
+        num_dry = 2;
+
+        // Account for haas effect
+        int haas_addr_left = haas_temp_addr >> 16;
+        int haas_addr_right = haas_temp_addr & 0xFFFF;
+
+        if (haas_addr_left) {
+            dry[0] = BUF_S16(haas_addr_left);
+        } else if (haas_addr_right) {
+            dry[1] = BUF_S16(haas_addr_right);
+        }
+
+        negs[0] = _mm256_set1_epi16(neg_left ? 0 : -1);
+        negs[1] = _mm256_set1_epi16(neg_right ? 0 : -1);
+    }
+
+    int groups = n / 8;
+    int group = 0;
+
+    // Two groups of 8 samples at a time, the volumes ramp once per group
+    for (; group + 2 <= groups; group += 2) {
+        __m256i samples = _mm256_loadu_si256((__m256i*) in);
+        __m256i vol_wet_vec = _mm256_setr_m128i(_mm_set1_epi16(vol_wet), _mm_set1_epi16(vol_wet + rspa.rate_wet));
+        __m256i mixed[6];
+
+        for (int j = 0; j < num_dry; j++) {
+            __m256i vol_vec = _mm256_setr_m128i(_mm_set1_epi16(vols[j]), _mm_set1_epi16(vols[j] + rspa.rate[j]));
+            mixed[j] = _mm256_and_si256(MulHiSignedUnsigned(samples, vol_vec), negs[j]);
+            vols[j] += 2 * rspa.rate[j];
+        }
+        if (num_channels == 6) {
+            mixed[3] = FilterLfe(mixed[3], 16, alpha);
+        }
+
+        for (int j = 0; j < num_dry; j++) {
+            _mm256_storeu_si256((__m256i*) dry[j],
+                                _mm256_adds_epi16(_mm256_loadu_si256((__m256i*) dry[j]), mixed[j]));
+            dry[j] += 16;
+        }
+
+        for (int j = 0; j < 2; j++) {
+            __m256i reverb = MulHiSignedUnsigned(mixed[swap_reverb ? 1 - j : j], vol_wet_vec);
+            _mm256_storeu_si256((__m256i*) wet[j], _mm256_adds_epi16(_mm256_loadu_si256((__m256i*) wet[j]), reverb));
+            wet[j] += 16;
+        }
+
+        vol_wet += 2 * rspa.rate_wet;
+        in += 16;
+    }
+
+    for (; group < groups; group++) {
+        __m128i samples = _mm_loadu_si128((__m128i*) in);
+        __m128i vol_wet_vec = _mm_set1_epi16(vol_wet);
+        __m128i mixed[6];
+
+        for (int j = 0; j < num_dry; j++) {
+            mixed[j] = _mm_and_si128(MulHiSignedUnsigned128(samples, _mm_set1_epi16(vols[j])),
+                                     _mm256_castsi256_si128(negs[j]));
+            vols[j] += rspa.rate[j];
+        }
+        if (num_channels == 6) {
+            mixed[3] = _mm256_castsi256_si128(FilterLfe(_mm256_castsi128_si256(mixed[3]), 8, alpha));
+        }
+
+        for (int j = 0; j < num_dry; j++) {
+            _mm_storeu_si128((__m128i*) dry[j], _mm_adds_epi16(_mm_loadu_si128((__m128i*) dry[j]), mixed[j]));
+            dry[j] += 8;
+        }
+
+        for (int j = 0; j < 2; j++) {
+            __m128i reverb = MulHiSignedUnsigned128(mixed[swap_reverb ? 1 - j : j], vol_wet_vec);
+            _mm_storeu_si128((__m128i*) wet[j], _mm_adds_epi16(_mm_loadu_si128((__m128i*) wet[j]), reverb));
+            wet[j] += 8;
+        }
+
+        vol_wet += rspa.rate_wet;
+        in += 8;
+    }
+}
+
+AVX2_TARGET static void aMixAVX2(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
+    int nbytes = ROUND_UP_32(ROUND_DOWN_16(count << 4));
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+
+    if (gain == -0x8000) {
+        while (nbytes > 0) {
+            __m256i out_vec = _mm256_loadu_si256((__m256i*) out);
+            __m256i in_vec = _mm256_loadu_si256((__m256i*) in);
+            _mm256_storeu_si256((__m256i*) out, _mm256_subs_epi16(out_vec, in_vec));
+            nbytes -= 16 * sizeof(int16_t);
+            in += 16;
+            out += 16;
+        }
+    }
+
+    // Interleaving out and in turns out * 0x7fff + in * gain into one multiply-add per pair
+    const __m256i weights = _mm256_set1_epi32((int32_t) (((uint32_t) (uint16_t) gain << 16) | 0x7fff));
+    const __m256i round = _mm256_set1_epi32(0x4000);
+
+    while (nbytes > 0) {
+        __m256i out_vec = _mm256_loadu_si256((__m256i*) out);
+        __m256i in_vec = _mm256_loadu_si256((__m256i*) in);
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(out_vec, in_vec), weights);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(out_vec, in_vec), weights);
+        lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), 15);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), 15);
+        _mm256_storeu_si256((__m256i*) out, _mm256_packs_epi32(lo, hi));
+
+        in += 16;
+        out += 16;
+        nbytes -= 16 * sizeof(int16_t);
+    }
+}
+
+AVX2_TARGET static void aS8DecAVX2(uint8_t flags, ADPCM_STATE state) {
+    uint8_t* in = BUF_U8(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_32(rspa.nbytes);
+    Mixer_LoadDecodeState(flags, state, out);
+    out += 16;
+
+    while (nbytes > 0) {
+        __m256i samples = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*) in));
+        _mm256_storeu_si256((__m256i*) out, _mm256_slli_epi16(samples, 8));
+        in += 16;
+        out += 16;
+
+        nbytes -= 16 * sizeof(int16_t);
+    }
+
+    memcpy(state, out - 16, 16 * sizeof(int16_t));
+}
+
+AVX2_TARGET static void aAddMixerAVX2(uint16_t count, uint16_t in_addr, uint16_t out_addr) {
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+    int nbytes = ROUND_UP_64(ROUND_DOWN_16(count));
+
+    do {
+        __m256i sum = _mm256_adds_epi16(_mm256_loadu_si256((__m256i*) out), _mm256_loadu_si256((__m256i*) in));
+        _mm256_storeu_si256((__m256i*) out, sum);
+        in += 16;
+        out += 16;
+
+        nbytes -= 16 * sizeof(int16_t);
+    } while (nbytes > 0);
+}
+
+AVX2_TARGET static void aInterlAVX2(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+    int n = ROUND_UP_8(n_samples);
+    // Like the reference, at least one group of 8 is always written
+    int remaining = n > 0 ? n : 8;
+
+    // Keeping the low half of every 32-bit pair and packing them back together leaves the even samples
+    const __m256i even = _mm256_set1_epi32(0xFFFF);
+    for (; remaining >= 16; remaining -= 16) {
+        __m256i a = _mm256_and_si256(_mm256_loadu_si256((__m256i*) in), even);
+        __m256i b = _mm256_and_si256(_mm256_loadu_si256((__m256i*) (in + 16)), even);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*) out, packed);
+        in += 32;
+        out += 16;
+    }
+
+    if (remaining > 0) {
+        __m128i a = _mm_and_si128(_mm_loadu_si128((__m128i*) in), _mm256_castsi256_si128(even));
+        __m128i b = _mm_and_si128(_mm_loadu_si128((__m128i*) (in + 8)), _mm256_castsi256_si128(even));
+        _mm_storeu_si128((__m128i*) out, _mm_packus_epi32(a, b));
+    }
+}
+
+AVX2_TARGET static void aFilterAVX2(uint8_t flags, uint16_t buf_addr, int16_t* state) {
+    int16_t tmp[16], tmp2[8];
+    int count = rspa.filter_count;
+    int16_t* buf = BUF_S16(buf_addr);
+
+    if (flags == A_INIT) {
+        memset(tmp, 0, sizeof(tmp));
+        memset(tmp2, 0, sizeof(tmp2));
+    } else {
+        memcpy(tmp, state, 8 * sizeof(int16_t));
+        memcpy(tmp2, state + 8, 8 * sizeof(int16_t));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        rspa.filter[i] = (tmp2[i] + rspa.filter[i]) / 2;
+    }
+
+    __m256i taps[8];
+    for (int j = 0; j < 8; j++) {
+        taps[j] = _mm256_set1_epi32(rspa.filter[7 - j]);
+    }
+
+    // The sum of 8 products can take 34 bits. Splitting every product into its part above and below bit 15 keeps
+    // both sums in 32 bits and still rounds exactly like the 64-bit reference.
+    const __m256i low_bits = _mm256_set1_epi32(0x7fff);
+    const __m256i round = _mm256_set1_epi32(0x4000);
+
+    do {
+        memcpy(tmp + 8, buf, 8 * sizeof(int16_t));
+
+        __m256i high_sum = _mm256_setzero_si256();
+        __m256i low_sum = round;
+        for (int j = 0; j < 8; j++) {
+            __m256i window = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*) (tmp + j)));
+            __m256i product = _mm256_mullo_epi32(window, taps[j]);
+            high_sum = _mm256_add_epi32(high_sum, _mm256_srai_epi32(product, 15));
+            low_sum = _mm256_add_epi32(low_sum, _mm256_and_si256(product, low_bits));
+        }
+        __m256i result = _mm256_add_epi32(high_sum, _mm256_srai_epi32(low_sum, 15));
+        _mm_storeu_si128((__m128i*) buf, PackToInt16(result));
+
+        memcpy(tmp, tmp + 8, 8 * sizeof(int16_t));
+
+        buf += 8;
+        count -= 8 * sizeof(int16_t);
+    } while (count > 0);
+
+    memcpy(state, tmp, 8 * sizeof(int16_t));
+    memcpy(state + 8, rspa.filter, 8 * sizeof(int16_t));
+}
+
+AVX2_TARGET static void aHiLoGainAVX2(uint8_t g, uint16_t count, uint16_t addr) {
+    int16_t* samples = BUF_S16(addr);
+    int nbytes = ROUND_UP_32(count);
+    // The reference handles 8 samples per 8 bytes, and always at least 8
+    int remaining = nbytes > 0 ? nbytes : 8;
+
+    const __m256i gain = _mm256_set1_epi16(g);
+    for (; remaining >= 16; remaining -= 16) {
+        __m256i s = _mm256_loadu_si256((__m256i*) samples);
+        __m256i lo = _mm256_mullo_epi16(s, gain);
+        __m256i hi = _mm256_mulhi_epi16(s, gain);
+        __m256i products_lo = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 4);
+        __m256i products_hi = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 4);
+        _mm256_storeu_si256((__m256i*) samples, _mm256_packs_epi32(products_lo, products_hi));
+        samples += 16;
+    }
+
+    if (remaining > 0) {
+        __m128i s = _mm_loadu_si128((__m128i*) samples);
+        __m128i lo = _mm_mullo_epi16(s, _mm256_castsi256_si128(gain));
+        __m128i hi = _mm_mulhi_epi16(s, _mm256_castsi256_si128(gain));
+        __m128i products_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 4);
+        __m128i products_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 4);
+        _mm_storeu_si128((__m128i*) samples, _mm_packs_epi32(products_lo, products_hi));
+    }
+}
+
+// Interleaves the 32-bit elements of a, b and c within each 128-bit lane to a0 b0 c0 a1 | b1 c1 a2 b2 | c2 a3 b3 c3
+AVX2_TARGET static inline void InterleaveThree(__m256i a, __m256i b, __m256i c, __m256i out[3]) {
+    __m256 fa = _mm256_castsi256_ps(a);
+    __m256 fb = _mm256_castsi256_ps(b);
+    __m256 fc = _mm256_castsi256_ps(c);
+    __m256 ab_lo = _mm256_unpacklo_ps(fa, fb); // a0 b0 a1 b1
+    __m256 ab_hi = _mm256_unpackhi_ps(fa, fb); // a2 b2 a3 b3
+    __m256 bc_lo = _mm256_unpacklo_ps(fb, fc); // b0 c0 b1 c1
+    __m256 bc_hi = _mm256_unpackhi_ps(fb, fc); // b2 c2 b3 c3
+    __m256 ca_lo = _mm256_unpacklo_ps(fc, fa); // c0 a0 c1 a1
+    __m256 ca_hi = _mm256_unpackhi_ps(fc, fa); // c2 a2 c3 a3
+    out[0] = _mm256_castps_si256(_mm256_shuffle_ps(ab_lo, ca_lo, _MM_SHUFFLE(3, 0, 1, 0)));
+    out[1] = _mm256_castps_si256(_mm256_shuffle_ps(bc_lo, ab_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    out[2] = _mm256_castps_si256(_mm256_shuffle_ps(ca_hi, bc_hi, _MM_SHUFFLE(3, 2, 3, 0)));
+}
+
+AVX2_TARGET static void aInterleaveAVX2(int16_t* out, const int16_t* channels[6], int count, uint16_t num_channels) {
+    int i = 0;
+
+    if (num_channels == 2) {
+        // The unpacks work within 128-bit lanes, so the low lanes hold samples 0-7 and the high ones 8-15
+        for (; i + 16 <= count; i += 16) {
+            __m256i l = _mm256_loadu_si256((__m256i*) (channels[0] + i));
+            __m256i r = _mm256_loadu_si256((__m256i*) (channels[1] + i));
+            __m256i lo = _mm256_unpacklo_epi16(l, r);
+            __m256i hi = _mm256_unpackhi_epi16(l, r);
+            _mm256_storeu_si256((__m256i*) out, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*) (out + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+            out += 32;
+        }
+        for (; i < count; i++) {
+            *out++ = channels[0][i];
+            *out++ = channels[1][i];
+        }
+        return;
+    }
+
+    // Pairing the channels up as left/right, center/subwoofer and the two surrounds leaves three streams of 32-bit
+    // values to interleave
+    for (; i + 16 <= count; i += 16) {
+        __m256i pairs[3][2];
+        for (int p = 0; p < 3; p++) {
+            __m256i a = _mm256_loadu_si256((__m256i*) (channels[p * 2] + i));
+            __m256i b = _mm256_loadu_si256((__m256i*) (channels[p * 2 + 1] + i));
+            pairs[p][0] = _mm256_unpacklo_epi16(a, b); // samples 0-3 | 8-11
+            pairs[p][1] = _mm256_unpackhi_epi16(a, b); // samples 4-7 | 12-15
+        }
+
+        __m256i first[3];
+        __m256i second[3];
+        InterleaveThree(pairs[0][0], pairs[1][0], pairs[2][0], first);
+        InterleaveThree(pairs[0][1], pairs[1][1], pairs[2][1], second);
+
+        _mm256_storeu_si256((__m256i*) out, _mm256_permute2x128_si256(first[0], first[1], 0x20));
+        _mm256_storeu_si256((__m256i*) (out + 16), _mm256_permute2x128_si256(first[2], second[0], 0x20));
+        _mm256_storeu_si256((__m256i*) (out + 32), _mm256_permute2x128_si256(second[1], second[2], 0x20));
+        _mm256_storeu_si256((__m256i*) (out + 48), _mm256_permute2x128_si256(first[0], first[1], 0x31));
+        _mm256_storeu_si256((__m256i*) (out + 64), _mm256_permute2x128_si256(first[2], second[0], 0x31));
+        _mm256_storeu_si256((__m256i*) (out + 80), _mm256_permute2x128_si256(second[1], second[2], 0x31));
+        out += 96;
+    }
+    for (; i < count; i++) {
+        for (int j = 0; j < 6; j++) {
+            *out++ = channels[j][i];
+        }
+    }
+}
+
+AVX2_TARGET static void aDownsampleAVX2(int16_t* out, const int16_t* in, int count, int step) {
+    int i = 0;
+
+    // Only the reverbs' rate of 2 is vectorized. The even samples are sign extended in place and packed back,
+    // which works within 128-bit lanes, so the permute puts the 64-bit halves back in order.
+    if (step == 2) {
+        for (; i + 16 <= count; i += 16) {
+            __m256i a = _mm256_loadu_si256((__m256i*) (in + i * 2));
+            __m256i b = _mm256_loadu_si256((__m256i*) (in + i * 2 + 16));
+            a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+            b = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+            _mm256_storeu_si256((__m256i*) (out + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8));
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = in[i * step];
+    }
+}
+
+const MixerKernels gMixerKernelsAVX2 = {
+    "avx2",        aADPCMdecAVX2, aResampleAVX2, aEnvMixerAVX2, aMixAVX2,        aS8DecAVX2,
+    aAddMixerAVX2, aInterlAVX2,   aFilterAVX2,   aHiLoGainAVX2, aInterleaveAVX2, aDownsampleAVX2,
+};
+
+#endif
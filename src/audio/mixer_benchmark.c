@@ -0,0 +1,96 @@
+#include <stdio.h>
+
+#include "mixer_internal.h"
+
+/*
+ * Times the mixing stage of the audio update with every kernel set the CPU supports. Each note runs the envelope
+ * mixer into the dry and wet channel buffers for every tick of the update, and the channels are interleaved to
+ * the output once per tick, like AudioSynth_DoOneAudioUpdate does.
+ *
+ * This runs on a state of its own, so the audio thread keeps playing while it does.
+ */
+
+// A 60 Hz update at 32 kHz is three ticks of about 180 samples. The envelope mixer works in groups of 16.
+#define BENCHMARK_TICKS 3
+#define BENCHMARK_TICK_SAMPLES 176
+
+#define BENCHMARK_IN 0x450
+#define BENCHMARK_DRY (BENCHMARK_IN + 192 * sizeof(int16_t))
+#define BENCHMARK_WET (BENCHMARK_DRY + 6 * 192 * sizeof(int16_t))
+
+static MixerState sBenchmarkState;
+
+static void Benchmark_ResetState(void) {
+    uint32_t rng = 0x12345678;
+
+    for (size_t i = 0; i < sizeof(sBenchmarkState.buf); i += sizeof(int16_t)) {
+        // Quiet random samples, so the mix doesn't sit at the clamp
+        rng = rng * 1664525 + 1013904223;
+        int16_t sample = (int16_t) (rng >> 16) >> 4;
+        memcpy(sBenchmarkState.buf + i, &sample, sizeof(sample));
+    }
+
+    for (int i = 0; i < 6; i++) {
+        sBenchmarkState.vol[i] = 0x4000;
+        sBenchmarkState.rate[i] = 0x10;
+    }
+    sBenchmarkState.vol_wet = 0x2000;
+    sBenchmarkState.rate_wet = 0x10;
+    sBenchmarkState.prev_lfe_sample = 0.0f;
+}
+
+void Mixer_BenchmarkKernels(uint32_t notes, uint32_t updates, uint32_t num_channels, double (*now)(void),
+                            void (*report)(void* user_data, const char* line), void* user_data) {
+    const MixerKernels* sets[4];
+    uint32_t set_count = Mixer_GetAvailableKernels(sets);
+    MixerState* previous_state = gMixerState;
+    double reference = 0.0;
+    char line[160];
+
+    gMixerState = &sBenchmarkState;
+
+    for (uint32_t s = 0; s < set_count; s++) {
+        const MixerKernels* kernels = sets[s];
+        double env_mixer_time = 0.0;
+        double interleave_time = 0.0;
+
+        Benchmark_ResetState();
+
+        const int16_t* channels[6];
+        for (int i = 0; i < 6; i++) {
+            channels[i] = BUF_S16(BENCHMARK_DRY + i * 192 * sizeof(int16_t));
+        }
+
+        for (uint32_t update = 0; update < updates; update++) {
+            for (int tick = 0; tick < BENCHMARK_TICKS; tick++) {
+                double start = now();
+                for (uint32_t note = 0; note < notes; note++) {
+                    kernels->envMixer(BENCHMARK_IN, BENCHMARK_TICK_SAMPLES, note & 1, false, false,
+                                      (BENCHMARK_WET << 16) | BENCHMARK_DRY, 0, num_channels, 120);
+                }
+                double mixed = now();
+                // The wet buffers are free by now and hold the interleaved tick
+                kernels->interleave(BUF_S16(BENCHMARK_WET), channels, BENCHMARK_TICK_SAMPLES, num_channels);
+                double end = now();
+
+                env_mixer_time += mixed - start;
+                interleave_time += end - mixed;
+            }
+        }
+
+        double per_note = env_mixer_time / ((double) updates * notes) * 1e9;
+        double per_update = interleave_time / updates * 1e9;
+        double total = (env_mixer_time + interleave_time) / updates * 1e6;
+        if (s == 0) {
+            reference = total;
+        }
+
+        snprintf(line, sizeof(line),
+                 "%-6s env mixer %7.1f ns per note per update, interleave %7.1f ns per update, %7.2f us total "
+                 "(%.2fx)",
+                 kernels->name, per_note, per_update, total, total > 0.0 ? reference / total : 0.0);
+        report(user_data, line);
+    }
+
+    gMixerState = previous_state;
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mixer.h"
+
+/*
+ * Shared between the mixer command implementations in mixer.c and the SIMD kernels in mixer_avx2.c and
+ * mixer_neon.c. Each kernel set implements the commands that do the bulk of the sample processing, and
+ * mixer.c picks the best set the CPU supports the first time a command runs. Every set has to produce
+ * exactly the same DMEM contents as the scalar one, which the audio_mixer_verify console command checks.
+ */
+
+#if defined(__SSE2__)
+#define MIXER_SSE2
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MIXER_AVX2
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define MIXER_NEON
+#endif
+
+#if defined(_MSC_VER)
+#define MIXER_THREAD_LOCAL __declspec(thread)
+#else
+#define MIXER_THREAD_LOCAL _Thread_local
+#endif
+
+#define ROUND_UP_64(v) (((v) + 63) & ~63)
+#define ROUND_UP_32(v) (((v) + 31) & ~31)
+#define ROUND_UP_16(v) (((v) + 15) & ~15)
+#define ROUND_UP_8(v) (((v) + 7) & ~7)
+#define ROUND_DOWN_16(v) ((v) & ~0xf)
+
+#define DMEM_BUF_SIZE (0x1B90) // 7056 B
+#define BUF_U8(a) (rspa.buf + ((a) -0x450))
+#define BUF_S16(a) (int16_t*) BUF_U8(a)
+
+// Rate the mixer's output plays at, see Mixer_SetSampleRate
+extern uint32_t gMixerSampleRate;
+
+typedef struct MixerState {
+    uint16_t in;
+    uint16_t out;
+    uint16_t nbytes;
+
+    uint16_t vol[6];
+    uint16_t rate[6];
+    uint16_t vol_wet;
+    uint16_t rate_wet;
+
+    ADPCM_STATE* adpcm_loop_state;
+
+    int16_t adpcm_table[8][2][8];
+
+    uint16_t filter_count;
+    int16_t filter[8];
+
+    // Low-pass filter state for the subwoofer channel
+    float prev_lfe_sample;
+
+    uint8_t buf[DMEM_BUF_SIZE];
+} MixerState;
+
+// The state the mixer commands of the calling thread work on. It points to the audio thread's state unless a
+// thread sets its own, like the kernel verification and the parallel note synthesis do.
+extern MIXER_THREAD_LOCAL MixerState* gMixerState;
+#define rspa (*gMixerState)
+
+typedef struct {
+    const char* name;
+    void (*adpcmDec)(uint8_t flags, ADPCM_STATE state);
+    void (*resample)(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state);
+    void (*envMixer)(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left, bool neg_right,
+                     uint32_t wet_dry_addr, uint32_t haas_temp_addr, uint32_t num_channels,
+                     uint32_t cutoff_freq_lfe);
+    void (*mix)(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr);
+    void (*s8Dec)(uint8_t flags, ADPCM_STATE state);
+    void (*addMixer)(uint16_t count, uint16_t in_addr, uint16_t out_addr);
+    void (*interl)(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples);
+    // Only the filtering half of aFilter, setting the filter up is the same everywhere
+    void (*filter)(uint8_t flags, uint16_t buf_addr, int16_t* state);
+    void (*hiLoGain)(uint8_t g, uint16_t count, uint16_t addr);
+    // Interleaves count samples of each channel to the output, 2 or 6 channels
+    void (*interleave)(int16_t* out, const int16_t* channels[6], int count, uint16_t num_channels);
+    // Copies every step-th sample of in to out, for the reverbs that run below the output rate
+    void (*downsample)(int16_t* out, const int16_t* in, int count, int step);
+} MixerKernels;
+
+extern const MixerKernels gMixerKernelsScalar;
+#ifdef MIXER_SSE2
+extern const MixerKernels gMixerKernelsSSE2;
+#endif
+#ifdef MIXER_AVX2
+extern const MixerKernels gMixerKernelsAVX2;
+bool Mixer_CpuSupportsAVX2(void);
+#endif
+#ifdef MIXER_NEON
+extern const MixerKernels gMixerKernelsNEON;
+#endif
+
+// Fills sets with the kernel sets this CPU can run, scalar first, and returns how many there are
+uint32_t Mixer_GetAvailableKernels(const MixerKernels* sets[4]);
+
+extern int16_t resample_table[64][4];
+
+// Coefficient of the subwoofer channel's one-pole low-pass
+static inline float Mixer_LfeAlpha(uint32_t cutoff_freq_lfe) {
+    float RC = 1.f / (2 * M_PI * cutoff_freq_lfe);
+    float dt = 1.f / gMixerSampleRate;
+    return dt / (RC + dt);
+}
+
+// Runs one subwoofer sample through the low-pass. Every kernel set uses this, so they round the same way.
+static inline int16_t Mixer_FilterLfe(int16_t sample, float alpha) {
+    float lfe_sample = sample;
+    lfe_sample = alpha * lfe_sample + (1.0f - alpha) * rspa.prev_lfe_sample;
+    rspa.prev_lfe_sample = lfe_sample;
+    return (int16_t) lfe_sample;
+}
+
+static inline int16_t clamp16(int32_t v) {
+    if (v < -0x8000) {
+        return -0x8000;
+    } else if (v > 0x7fff) {
+        return 0x7fff;
+    }
+    return (int16_t) v;
+}
+
+// Writes the 16 samples a decoded block continues from in front of out
+static inline void Mixer_LoadDecodeState(uint8_t flags, ADPCM_STATE state, int16_t* out) {
+    if (flags & A_INIT) {
+        memset(out, 0, 16 * sizeof(int16_t));
+    } else if (flags & A_LOOP) {
+        memcpy(out, rspa.adpcm_loop_state, 16 * sizeof(int16_t));
+    } else {
+        memcpy(out, state, 16 * sizeof(int16_t));
+    }
+}
+
+// Puts the samples resampling continues from in front of in, and returns where the first output reads from
+static inline int16_t* Mixer_BeginResample(uint8_t flags, RESAMPLE_STATE state, int16_t* in,
+                                           uint32_t* pitch_accumulator) {
+    int16_t tmp[16];
+
+    if (flags & A_INIT) {
+        memset(tmp, 0, 5 * sizeof(int16_t));
+    } else {
+        memcpy(tmp, state, 16 * sizeof(int16_t));
+    }
+    if (flags & 2) {
+        memcpy(in - 8, tmp + 8, 8 * sizeof(int16_t));
+        in -= tmp[5] / sizeof(int16_t);
+    }
+    in -= 4;
+    *pitch_accumulator = (uint16_t) tmp[4];
+    memcpy(in, tmp, 4 * sizeof(int16_t));
+    return in;
+}
+
+static inline void Mixer_EndResample(RESAMPLE_STATE state, int16_t* in, int16_t* in_initial,
+                                     uint32_t pitch_accumulator) {
+    int i;
+
+    state[4] = (int16_t) pitch_accumulator;
+    memcpy(state, in, 4 * sizeof(int16_t));
+    i = (in - in_initial + 4) & 7;
+    in -= i;
+    if (i != 0) {
+        i = -8 - i;
+    }
+    state[5] = i;
+    memcpy(state + 8, in, 8 * sizeof(int16_t));
+}
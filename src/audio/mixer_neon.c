@@ -0,0 +1,400 @@
+#include <stdio.h>
+
+#include "mixer_internal.h"
+
+#ifdef MIXER_NEON
+
+#include <arm_neon.h>
+
+// (a * b) >> 16 with a signed and b unsigned, truncated to 16 bits
+static inline int16x8_t MulHiSignedUnsigned(int16x8_t a, uint16_t b) {
+    int32x4_t lo = vmulq_n_s32(vmovl_s16(vget_low_s16(a)), b);
+    int32x4_t hi = vmulq_n_s32(vmovl_s16(vget_high_s16(a)), b);
+    return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+}
+
+static void aADPCMdecNEON(uint8_t flags, ADPCM_STATE state) {
+    uint8_t* in = BUF_U8(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_32(rspa.nbytes);
+    Mixer_LoadDecodeState(flags, state, out);
+    out += 16;
+
+    // Left shifts of 0, 2, 4 and 6 for the samples of each byte
+    const int8x8_t shifts_2bit = vcreate_s8(0x0604020006040200ull);
+
+    while (nbytes > 0) {
+        int shift = *in >> 4;          // should be in 0..12 or 0..14
+        int table_index = *in++ & 0xf; // should be in 0..7
+        int16_t(*tbl)[8] = rspa.adpcm_table[table_index];
+        int16x8_t shift_vec = vdupq_n_s16(shift);
+
+        // Each of the 8 outputs also adds tbl[1][j - k - 1] * ins[k] for every earlier input k of its group.
+        // Loading tbl[1] from behind 8 zeros gives those coefficients as one column per k.
+        int16_t padded[16] = { 0 };
+        memcpy(padded + 8, tbl[1], 8 * sizeof(int16_t));
+        int16x8_t columns[7];
+        for (int k = 0; k < 7; k++) {
+            columns[k] = vld1q_s16(padded + 7 - k);
+        }
+        int16x8_t tbl0 = vld1q_s16(tbl[0]);
+        int16x8_t tbl1 = vld1q_s16(tbl[1]);
+
+        for (int i = 0; i < 2; i++) {
+            int8x8_t nibbles;
+            if (flags & 4) {
+                // Every byte holds four 2-bit samples, highest bits first. Each sample is moved to the top of its
+                // own byte and shifted back down with its sign.
+                uint64_t bytes = in[0] * 0x01010101ull | in[1] * 0x0101010100000000ull;
+                uint8x8_t top = vshl_u8(vcreate_u8(bytes), shifts_2bit);
+                nibbles = vshr_n_s8(vreinterpret_s8_u8(top), 6);
+                in += 2;
+            } else {
+                uint32_t bytes;
+                memcpy(&bytes, in, sizeof(bytes));
+                uint8x8_t packed = vcreate_u8(bytes);
+                uint8x8_t samples = vzip_u8(vshr_n_u8(packed, 4), vand_u8(packed, vdup_n_u8(0xf))).val[0];
+                nibbles = vshr_n_s8(vshl_n_s8(vreinterpret_s8_u8(samples), 4), 4);
+                in += 4;
+            }
+            int16x8_t ins_vec = vshlq_s16(vmovl_s8(nibbles), shift_vec);
+
+            int16_t ins[8];
+            vst1q_s16(ins, ins_vec);
+
+            int32x4_t acc_lo = vmull_n_s16(vget_low_s16(tbl0), out[-2]);
+            int32x4_t acc_hi = vmull_n_s16(vget_high_s16(tbl0), out[-2]);
+            acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(tbl1), out[-1]);
+            acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(tbl1), out[-1]);
+            acc_lo = vaddq_s32(acc_lo, vshll_n_s16(vget_low_s16(ins_vec), 11));
+            acc_hi = vaddq_s32(acc_hi, vshll_n_s16(vget_high_s16(ins_vec), 11));
+            for (int k = 0; k < 7; k++) {
+                acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(columns[k]), ins[k]);
+                acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(columns[k]), ins[k]);
+            }
+
+            vst1q_s16(out, vcombine_s16(vqmovn_s32(vshrq_n_s32(acc_lo, 11)), vqmovn_s32(vshrq_n_s32(acc_hi, 11))));
+            out += 8;
+        }
+        nbytes -= 16 * sizeof(int16_t);
+    }
+    memcpy(state, out - 16, 16 * sizeof(int16_t));
+}
+
+static void aResampleNEON(uint8_t flags, uint16_t pitch, RESAMPLE_STATE state) {
+    int16_t* in_initial = BUF_S16(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_16(rspa.nbytes);
+    uint32_t pitch_accumulator;
+    int16_t* in = Mixer_BeginResample(flags, state, in_initial, &pitch_accumulator);
+
+    do {
+        int32x4_t terms[8];
+        for (int i = 0; i < 8; i++) {
+            int16_t* tbl = resample_table[pitch_accumulator * 64 >> 16];
+            // Every product is rounded on its own before the four are added, like the reference
+            terms[i] = vrshrq_n_s32(vmull_s16(vld1_s16(in), vld1_s16(tbl)), 15);
+
+            pitch_accumulator += (pitch << 1);
+            in += pitch_accumulator >> 16;
+            pitch_accumulator %= 0x10000;
+        }
+
+        int32x4_t sums_lo = vpaddq_s32(vpaddq_s32(terms[0], terms[1]), vpaddq_s32(terms[2], terms[3]));
+        int32x4_t sums_hi = vpaddq_s32(vpaddq_s32(terms[4], terms[5]), vpaddq_s32(terms[6], terms[7]));
+        vst1q_s16(out, vcombine_s16(vqmovn_s32(sums_lo), vqmovn_s32(sums_hi)));
+        out += 8;
+
+        nbytes -= 8 * sizeof(int16_t);
+    } while (nbytes > 0);
+
+    Mixer_EndResample(state, in, in_initial, pitch_accumulator);
+}
+
+static void aEnvMixerNEON(uint16_t in_addr, uint16_t n_samples, bool swap_reverb, bool neg_left, bool neg_right,
+                          uint32_t wet_dry_addr, uint32_t haas_temp_addr, uint32_t num_channels,
+                          uint32_t cutoff_freq_lfe) {
+    int max_num_samples = 192;
+
+    int16_t* in = BUF_S16(in_addr);
+    int n = ROUND_UP_16(n_samples);
+    if (n > max_num_samples) {
+        printf("Warning: n_samples is too large: %d\n", n_samples);
+    }
+
+    int dry_addr_start = wet_dry_addr & 0xFFFF;
+    int wet_addr_start = wet_dry_addr >> 16;
+
+    // Only the front channels get reverb
+    int16_t* dry[6];
+    int16_t* wet[2];
+    for (int i = 0; i < 6; i++) {
+        dry[i] = BUF_S16(dry_addr_start + max_num_samples * i * sizeof(int16_t));
+    }
+    for (int i = 0; i < 2; i++) {
+        wet[i] = BUF_S16(wet_addr_start + max_num_samples * i * sizeof(int16_t));
+    }
+
+    uint16_t vols[6] = { rspa.vol[0], rspa.vol[1], rspa.vol[2], rspa.vol[3], rspa.vol[4], rspa.vol[5] };
+    uint16_t vol_wet = rspa.vol_wet;
+    int16x8_t negs[6];
+    for (int i = 0; i < 6; i++) {
+        negs[i] = vdupq_n_s16(-1);
+    }
+    float alpha = 0.0f;
+    int num_dry;
+
+    if (num_channels == 6) {
+        num_dry = 6;
+        alpha = Mixer_LfeAlpha(cutoff_freq_lfe);
+    } else {
+        num_dry = 2;
+
+        // Account for haas effect
+        int haas_addr_left = haas_temp_addr >> 16;
+        int haas_addr_right = haas_temp_addr & 0xFFFF;
+
+        if (haas_addr_left) {
+            dry[0] = BUF_S16(haas_addr_left);
+        } else if (haas_addr_right) {
+            dry[1] = BUF_S16(haas_addr_right);
+        }
+
+        negs[0] = vdupq_n_s16(neg_left ? 0 : -1);
+        negs[1] = vdupq_n_s16(neg_right ? 0 : -1);
+    }
+
+    for (int i = 0; i < n / 8; i++) {
+        int16x8_t samples = vld1q_s16(in);
+        int16x8_t mixed[6];
+
+        for (int j = 0; j < num_dry; j++) {
+            mixed[j] = vandq_s16(MulHiSignedUnsigned(samples, vols[j]), negs[j]);
+            vols[j] += rspa.rate[j];
+        }
+        if (num_channels == 6) {
+            // The low-pass runs sample by sample
+            int16_t lfe[8];
+            vst1q_s16(lfe, mixed[3]);
+            for (int k = 0; k < 8; k++) {
+                lfe[k] = Mixer_FilterLfe(lfe[k], alpha);
+            }
+            mixed[3] = vld1q_s16(lfe);
+        }
+
+        for (int j = 0; j < num_dry; j++) {
+            vst1q_s16(dry[j], vqaddq_s16(vld1q_s16(dry[j]), mixed[j]));
+            dry[j] += 8;
+        }
+
+        for (int j = 0; j < 2; j++) {
+            int16x8_t reverb = MulHiSignedUnsigned(mixed[swap_reverb ? 1 - j : j], vol_wet);
+            vst1q_s16(wet[j], vqaddq_s16(vld1q_s16(wet[j]), reverb));
+            wet[j] += 8;
+        }
+
+        vol_wet += rspa.rate_wet;
+        in += 8;
+    }
+}
+
+static void aMixNEON(uint16_t count, int16_t gain, uint16_t in_addr, uint16_t out_addr) {
+    int nbytes = ROUND_UP_32(ROUND_DOWN_16(count << 4));
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+
+    if (gain == -0x8000) {
+        while (nbytes > 0) {
+            vst1q_s16(out, vqsubq_s16(vld1q_s16(out), vld1q_s16(in)));
+            vst1q_s16(out + 8, vqsubq_s16(vld1q_s16(out + 8), vld1q_s16(in + 8)));
+            nbytes -= 16 * sizeof(int16_t);
+            in += 16;
+            out += 16;
+        }
+    }
+
+    while (nbytes > 0) {
+        for (int i = 0; i < 2; i++) {
+            int16x8_t out_vec = vld1q_s16(out);
+            int16x8_t in_vec = vld1q_s16(in);
+            int32x4_t lo = vmlal_n_s16(vmull_n_s16(vget_low_s16(out_vec), 0x7fff), vget_low_s16(in_vec), gain);
+            int32x4_t hi = vmlal_n_s16(vmull_n_s16(vget_high_s16(out_vec), 0x7fff), vget_high_s16(in_vec), gain);
+            vst1q_s16(out, vcombine_s16(vqmovn_s32(vrshrq_n_s32(lo, 15)), vqmovn_s32(vrshrq_n_s32(hi, 15))));
+            in += 8;
+            out += 8;
+        }
+
+        nbytes -= 16 * sizeof(int16_t);
+    }
+}
+
+static void aS8DecNEON(uint8_t flags, ADPCM_STATE state) {
+    uint8_t* in = BUF_U8(rspa.in);
+    int16_t* out = BUF_S16(rspa.out);
+    int nbytes = ROUND_UP_32(rspa.nbytes);
+    Mixer_LoadDecodeState(flags, state, out);
+    out += 16;
+
+    while (nbytes > 0) {
+        uint8x16_t samples = vld1q_u8(in);
+        vst1q_s16(out, vreinterpretq_s16_u16(vshll_n_u8(vget_low_u8(samples), 8)));
+        vst1q_s16(out + 8, vreinterpretq_s16_u16(vshll_n_u8(vget_high_u8(samples), 8)));
+        in += 16;
+        out += 16;
+
+        nbytes -= 16 * sizeof(int16_t);
+    }
+
+    memcpy(state, out - 16, 16 * sizeof(int16_t));
+}
+
+static void aAddMixerNEON(uint16_t count, uint16_t in_addr, uint16_t out_addr) {
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+    int nbytes = ROUND_UP_64(ROUND_DOWN_16(count));
+
+    do {
+        vst1q_s16(out, vqaddq_s16(vld1q_s16(out), vld1q_s16(in)));
+        vst1q_s16(out + 8, vqaddq_s16(vld1q_s16(out + 8), vld1q_s16(in + 8)));
+        in += 16;
+        out += 16;
+
+        nbytes -= 16 * sizeof(int16_t);
+    } while (nbytes > 0);
+}
+
+static void aInterlNEON(uint16_t in_addr, uint16_t out_addr, uint16_t n_samples) {
+    int16_t* in = BUF_S16(in_addr);
+    int16_t* out = BUF_S16(out_addr);
+    int n = ROUND_UP_8(n_samples);
+
+    do {
+        vst1q_s16(out, vld2q_s16(in).val[0]);
+        in += 16;
+        out += 8;
+
+        n -= 8;
+    } while (n > 0);
+}
+
+static void aFilterNEON(uint8_t flags, uint16_t buf_addr, int16_t* state) {
+    int16_t tmp[16], tmp2[8];
+    int count = rspa.filter_count;
+    int16_t* buf = BUF_S16(buf_addr);
+
+    if (flags == A_INIT) {
+        memset(tmp, 0, sizeof(tmp));
+        memset(tmp2, 0, sizeof(tmp2));
+    } else {
+        memcpy(tmp, state, 8 * sizeof(int16_t));
+        memcpy(tmp2, state + 8, 8 * sizeof(int16_t));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        rspa.filter[i] = (tmp2[i] + rspa.filter[i]) / 2;
+    }
+
+    // The sum of 8 products can take 34 bits. Splitting every product into its part above and below bit 15 keeps
+    // both sums in 32 bits and still rounds exactly like the 64-bit reference.
+    const int32x4_t low_bits = vdupq_n_s32(0x7fff);
+
+    do {
+        memcpy(tmp + 8, buf, 8 * sizeof(int16_t));
+
+        int32x4_t high_sums[2] = { vdupq_n_s32(0), vdupq_n_s32(0) };
+        int32x4_t low_sums[2] = { vdupq_n_s32(0x4000), vdupq_n_s32(0x4000) };
+        for (int j = 0; j < 8; j++) {
+            int16x8_t window = vld1q_s16(tmp + j);
+            int32x4_t products[2] = { vmull_n_s16(vget_low_s16(window), rspa.filter[7 - j]),
+                                      vmull_n_s16(vget_high_s16(window), rspa.filter[7 - j]) };
+            for (int h = 0; h < 2; h++) {
+                high_sums[h] = vaddq_s32(high_sums[h], vshrq_n_s32(products[h], 15));
+                low_sums[h] = vaddq_s32(low_sums[h], vandq_s32(products[h], low_bits));
+            }
+        }
+        int32x4_t lo = vaddq_s32(high_sums[0], vshrq_n_s32(low_sums[0], 15));
+        int32x4_t hi = vaddq_s32(high_sums[1], vshrq_n_s32(low_sums[1], 15));
+        vst1q_s16(buf, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+
+        memcpy(tmp, tmp + 8, 8 * sizeof(int16_t));
+
+        buf += 8;
+        count -= 8 * sizeof(int16_t);
+    } while (count > 0);
+
+    memcpy(state, tmp, 8 * sizeof(int16_t));
+    memcpy(state + 8, rspa.filter, 8 * sizeof(int16_t));
+}
+
+static void aHiLoGainNEON(uint8_t g, uint16_t count, uint16_t addr) {
+    int16_t* samples = BUF_S16(addr);
+    int nbytes = ROUND_UP_32(count);
+
+    do {
+        int16x8_t s = vld1q_s16(samples);
+        int32x4_t lo = vshrq_n_s32(vmull_n_s16(vget_low_s16(s), g), 4);
+        int32x4_t hi = vshrq_n_s32(vmull_n_s16(vget_high_s16(s), g), 4);
+        vst1q_s16(samples, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+        samples += 8;
+
+        nbytes -= 8;
+    } while (nbytes > 0);
+}
+
+static void aInterleaveNEON(int16_t* out, const int16_t* channels[6], int count, uint16_t num_channels) {
+    int i = 0;
+
+    if (num_channels == 2) {
+        for (; i + 8 <= count; i += 8) {
+            int16x8x2_t frames = { { vld1q_s16(channels[0] + i), vld1q_s16(channels[1] + i) } };
+            vst2q_s16(out, frames);
+            out += 16;
+        }
+        for (; i < count; i++) {
+            *out++ = channels[0][i];
+            *out++ = channels[1][i];
+        }
+        return;
+    }
+
+    // Pairing the channels up as left/right, center/subwoofer and the two surrounds leaves three streams of 32-bit
+    // values, which a 3-way store interleaves
+    for (; i + 8 <= count; i += 8) {
+        int16x8x2_t pairs[3];
+        for (int p = 0; p < 3; p++) {
+            pairs[p] = vzipq_s16(vld1q_s16(channels[p * 2] + i), vld1q_s16(channels[p * 2 + 1] + i));
+        }
+        for (int h = 0; h < 2; h++) {
+            int32x4x3_t frames = { { vreinterpretq_s32_s16(pairs[0].val[h]), vreinterpretq_s32_s16(pairs[1].val[h]),
+                                     vreinterpretq_s32_s16(pairs[2].val[h]) } };
+            vst3q_s32((int32_t*) out, frames);
+            out += 24;
+        }
+    }
+    for (; i < count; i++) {
+        for (int j = 0; j < 6; j++) {
+            *out++ = channels[j][i];
+        }
+    }
+}
+
+static void aDownsampleNEON(int16_t* out, const int16_t* in, int count, int step) {
+    int i = 0;
+
+    // Only the reverbs' rate of 2 is vectorized, a 2-way load splits the even samples out
+    if (step == 2) {
+        for (; i + 8 <= count; i += 8) {
+            vst1q_s16(out + i, vld2q_s16(in + i * 2).val[0]);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = in[i * step];
+    }
+}
+
+const MixerKernels gMixerKernelsNEON = {
+    "neon",        aADPCMdecNEON, aResampleNEON, aEnvMixerNEON, aMixNEON,        aS8DecNEON,
+    aAddMixerNEON, aInterlNEON,   aFilterNEON,   aHiLoGainNEON, aInterleaveNEON, aDownsampleNEON,
+};
+
+#endif
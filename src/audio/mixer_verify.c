@@ -0,0 +1,271 @@
+#include <stdio.h>
+
+#include "mixer_internal.h"
+
+/*
+ * Checks the SIMD kernel sets against the scalar reference. Every run fills a mixer state with random samples and
+ * command parameters, copies it, runs the scalar kernel on one copy and the kernel under test on the other, and
+ * compares the whole state and the command's state array afterwards. Only the kernels are compared, the SIMD sets
+ * are required to match bit for bit.
+ *
+ * The mixer state is thread local, so this runs on its own states without touching the audio thread's.
+ */
+
+// DMEM addresses the command buffers are placed at, each region is large enough for the biggest command
+#define VERIFY_REGION_A 0x450
+#define VERIFY_REGION_B 0x950
+#define VERIFY_REGION_C 0xE50
+
+#define VERIFY_MAX_BYTES 0x180
+
+typedef void (*VerifyCase)(const MixerKernels* kernels, uint32_t seed, int16_t* state);
+
+static MixerState sBaseState;
+static MixerState sExpectedState;
+static MixerState sActualState;
+static ADPCM_STATE sLoopState;
+
+static uint32_t Verify_Next(uint32_t* rng) {
+    // xorshift32, the state must never be 0
+    uint32_t x = *rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *rng = x;
+    return x;
+}
+
+static uint32_t Verify_Range(uint32_t* rng, uint32_t count) {
+    return Verify_Next(rng) % count;
+}
+
+// A DMEM address in the given region, offset by a random even amount
+static uint16_t Verify_Address(uint32_t* rng, uint16_t region) {
+    return region + Verify_Range(rng, 0x20) * sizeof(int16_t);
+}
+
+static void Verify_RandomizeState(uint32_t* rng) {
+    for (size_t i = 0; i < sizeof(sBaseState.buf); i += sizeof(uint32_t)) {
+        uint32_t value = Verify_Next(rng);
+        memcpy(sBaseState.buf + i, &value, sizeof(value));
+    }
+
+    for (int i = 0; i < 6; i++) {
+        sBaseState.vol[i] = Verify_Next(rng);
+        sBaseState.rate[i] = Verify_Next(rng);
+    }
+    sBaseState.vol_wet = Verify_Next(rng);
+    sBaseState.rate_wet = Verify_Next(rng);
+
+    // Real codebooks stay well inside 16 bits, which keeps the decoder's 32-bit sums from overflowing
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 2; j++) {
+            for (int k = 0; k < 8; k++) {
+                sBaseState.adpcm_table[i][j][k] = (int16_t) (Verify_Range(rng, 0x1000) - 0x800);
+            }
+        }
+    }
+
+    for (int i = 0; i < 16; i++) {
+        sLoopState[i] = (int16_t) Verify_Next(rng);
+    }
+    sBaseState.adpcm_loop_state = &sLoopState;
+
+    sBaseState.filter_count = ROUND_UP_16(Verify_Range(rng, VERIFY_MAX_BYTES + 1));
+    for (int i = 0; i < 8; i++) {
+        sBaseState.filter[i] = (int16_t) Verify_Next(rng);
+    }
+    sBaseState.prev_lfe_sample = (float) ((int16_t) Verify_Next(rng));
+}
+
+static void Verify_ADPCMdec(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    static const uint8_t flags[] = { A_CONTINUE, A_INIT, A_LOOP, 4, A_INIT | 4, A_LOOP | 4 };
+    uint32_t rng = seed;
+
+    rspa.in = Verify_Address(&rng, VERIFY_REGION_A);
+    rspa.out = Verify_Address(&rng, VERIFY_REGION_B);
+    rspa.nbytes = Verify_Range(&rng, VERIFY_MAX_BYTES + 1);
+    kernels->adpcmDec(flags[Verify_Range(&rng, sizeof(flags))], state);
+}
+
+static void Verify_Resample(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    // A_INIT together with A_LOOP reads state the game never passes in, so it isn't compared
+    static const uint8_t flags[] = { A_CONTINUE, A_INIT, A_LOOP };
+    uint32_t rng = seed;
+
+    // Continuing from an earlier resample, the read position in state[5] is one the previous call left
+    uint32_t position = Verify_Range(&rng, 8);
+    state[5] = position == 0 ? 0 : -8 - (int16_t) position;
+
+    rspa.in = Verify_Address(&rng, VERIFY_REGION_A + 0x40);
+    rspa.out = Verify_Address(&rng, VERIFY_REGION_C);
+    rspa.nbytes = Verify_Range(&rng, VERIFY_MAX_BYTES + 1);
+    kernels->resample(flags[Verify_Range(&rng, sizeof(flags))], Verify_Next(&rng), state);
+}
+
+static void Verify_EnvMixer(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    // The dry and wet buffers hold 6 channels of 192 samples each, the haas buffer follows them
+    uint16_t in_addr = VERIFY_REGION_A;
+    uint16_t dry_addr = in_addr + 192 * sizeof(int16_t);
+    uint16_t wet_addr = dry_addr + 6 * 192 * sizeof(int16_t);
+    uint16_t haas_addr = wet_addr + 6 * 192 * sizeof(int16_t);
+    uint32_t haas_temp_addr = 0;
+
+    switch (Verify_Range(&rng, 3)) {
+        case 1:
+            haas_temp_addr = (uint32_t) haas_addr << 16;
+            break;
+        case 2:
+            haas_temp_addr = haas_addr;
+            break;
+    }
+
+    uint16_t n_samples = Verify_Range(&rng, 192 + 1);
+    bool swap_reverb = Verify_Range(&rng, 2);
+    bool neg_left = Verify_Range(&rng, 2);
+    bool neg_right = Verify_Range(&rng, 2);
+    uint32_t num_channels = Verify_Range(&rng, 2) ? 6 : 2;
+    uint32_t cutoff_freq_lfe = 20 + Verify_Range(&rng, 200);
+    kernels->envMixer(in_addr, n_samples, swap_reverb, neg_left, neg_right, ((uint32_t) wet_addr << 16) | dry_addr,
+                      haas_temp_addr, num_channels, cutoff_freq_lfe);
+}
+
+static void Verify_Mix(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint16_t count = Verify_Range(&rng, (VERIFY_MAX_BYTES >> 4) + 1);
+    int16_t gain = Verify_Range(&rng, 4) == 0 ? -0x8000 : (int16_t) Verify_Next(&rng);
+    uint16_t in_addr = Verify_Address(&rng, VERIFY_REGION_A);
+    kernels->mix(count, gain, in_addr, Verify_Address(&rng, VERIFY_REGION_B));
+}
+
+static void Verify_S8Dec(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    static const uint8_t flags[] = { A_CONTINUE, A_INIT, A_LOOP };
+    uint32_t rng = seed;
+
+    rspa.in = Verify_Address(&rng, VERIFY_REGION_A);
+    rspa.out = Verify_Address(&rng, VERIFY_REGION_B);
+    rspa.nbytes = Verify_Range(&rng, VERIFY_MAX_BYTES + 1);
+    kernels->s8Dec(flags[Verify_Range(&rng, sizeof(flags))], state);
+}
+
+static void Verify_AddMixer(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint16_t count = Verify_Range(&rng, VERIFY_MAX_BYTES + 1);
+    uint16_t in_addr = Verify_Address(&rng, VERIFY_REGION_A);
+    kernels->addMixer(count, in_addr, Verify_Address(&rng, VERIFY_REGION_B));
+}
+
+static void Verify_Interl(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint16_t in_addr = Verify_Address(&rng, VERIFY_REGION_A);
+    uint16_t out_addr = Verify_Address(&rng, VERIFY_REGION_B);
+    kernels->interl(in_addr, out_addr, Verify_Range(&rng, 192 + 1));
+}
+
+static void Verify_Filter(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint8_t flags = Verify_Range(&rng, 2) ? A_INIT : A_CONTINUE;
+    kernels->filter(flags, Verify_Address(&rng, VERIFY_REGION_A), state);
+}
+
+static void Verify_HiLoGain(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint8_t g = Verify_Next(&rng);
+    uint16_t count = Verify_Range(&rng, VERIFY_MAX_BYTES + 1);
+    kernels->hiLoGain(g, count, Verify_Address(&rng, VERIFY_REGION_A));
+}
+
+static void Verify_Interleave(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    uint16_t num_channels = Verify_Range(&rng, 2) ? 6 : 2;
+    int count = Verify_Range(&rng, 192 + 1);
+    const int16_t* channels[6];
+    for (int i = 0; i < 6; i++) {
+        channels[i] = BUF_S16(VERIFY_REGION_A + i * 192 * sizeof(int16_t));
+    }
+    kernels->interleave(BUF_S16(Verify_Address(&rng, VERIFY_REGION_C)), channels, count, num_channels);
+}
+
+static void Verify_Downsample(const MixerKernels* kernels, uint32_t seed, int16_t* state) {
+    uint32_t rng = seed;
+
+    int step = 1 + Verify_Range(&rng, 3);
+    int count = Verify_Range(&rng, 192 + 1);
+    const int16_t* in = BUF_S16(Verify_Address(&rng, VERIFY_REGION_A));
+    kernels->downsample(BUF_S16(Verify_Address(&rng, VERIFY_REGION_C)), in, count, step);
+}
+
+static const struct {
+    const char* name;
+    VerifyCase run;
+} sVerifyCases[] = {
+    { "adpcm_dec", Verify_ADPCMdec },     { "resample", Verify_Resample },      { "env_mixer", Verify_EnvMixer },
+    { "mix", Verify_Mix },                { "s8_dec", Verify_S8Dec },           { "add_mixer", Verify_AddMixer },
+    { "interl", Verify_Interl },          { "filter", Verify_Filter },          { "hi_lo_gain", Verify_HiLoGain },
+    { "interleave", Verify_Interleave },  { "downsample", Verify_Downsample },
+};
+
+uint32_t Mixer_VerifyKernels(uint32_t iterations, uint32_t seed, void (*report)(void* user_data, const char* line),
+                             void* user_data) {
+    const MixerKernels* sets[4];
+    uint32_t set_count = Mixer_GetAvailableKernels(sets);
+    uint32_t total_mismatches = 0;
+    MixerState* previous_state = gMixerState;
+    char line[128];
+
+    if (set_count == 1) {
+        report(user_data, "No SIMD kernels available on this CPU");
+        return 0;
+    }
+
+    // The first set is the scalar reference itself
+    for (uint32_t s = 1; s < set_count; s++) {
+        for (size_t c = 0; c < sizeof(sVerifyCases) / sizeof(sVerifyCases[0]); c++) {
+            uint32_t rng = seed != 0 ? seed : 1;
+            uint32_t mismatches = 0;
+
+            for (uint32_t i = 0; i < iterations; i++) {
+                int16_t base_state[16];
+                int16_t expected_state[16];
+                int16_t actual_state[16];
+
+                Verify_RandomizeState(&rng);
+                for (int j = 0; j < 16; j++) {
+                    base_state[j] = (int16_t) Verify_Next(&rng);
+                }
+                uint32_t case_seed = Verify_Next(&rng);
+
+                memcpy(&sExpectedState, &sBaseState, sizeof(MixerState));
+                memcpy(&sActualState, &sBaseState, sizeof(MixerState));
+                memcpy(expected_state, base_state, sizeof(base_state));
+                memcpy(actual_state, base_state, sizeof(base_state));
+
+                gMixerState = &sExpectedState;
+                sVerifyCases[c].run(&gMixerKernelsScalar, case_seed, expected_state);
+                gMixerState = &sActualState;
+                sVerifyCases[c].run(sets[s], case_seed, actual_state);
+
+                if (memcmp(&sExpectedState, &sActualState, sizeof(MixerState)) != 0 ||
+                    memcmp(expected_state, actual_state, sizeof(expected_state)) != 0) {
+                    mismatches++;
+                }
+            }
+
+            snprintf(line, sizeof(line), "%s %s: %u/%u runs differ from scalar", sets[s]->name, sVerifyCases[c].name,
+                     mismatches, iterations);
+            report(user_data, line);
+            total_mismatches += mismatches;
+        }
+    }
+
+    gMixerState = previous_state;
+    return total_mismatches;
+}
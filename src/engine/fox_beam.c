@@ -5,6 +5,8 @@
 #include "assets/ast_versus.h"
 #include "port/interpolation/FrameInterpolation.h"
 
+static CVarHandle sRapidFireCVar = NULL;
+
 Vec3f sShotViewPos;
 
 void PlayerShot_SetupEffect351(Effect* effect, f32 xPos, f32 yPos, f32 zPos) {
@@ -1770,7 +1772,7 @@ void PlayerShot_SearchLockOnTarget(PlayerShot* shot) {
             Object_Kill(&shot->obj, shot->sfxSource);
         }
     } else {
-        bool rapidFire = CVarGetInteger("gRapidFire", 0) == 1;
+        bool rapidFire = CVarGetCachedInteger(&sRapidFireCVar, "gRapidFire", 0) == 1;
         if ((shot->obj.pos.y < gGroundHeight) || PlayerShot_FindLockTarget(shot) ||
             (!(gControllerHold[gMainController].button & A_BUTTON) ^ rapidFire) || (shot->timer == 0)) {
             Object_Kill(&shot->obj, shot->sfxSource);
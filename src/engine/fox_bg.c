@@ -25,6 +25,8 @@
 #include "port/interpolation/FrameInterpolation.h"
 // #include "prevent_bss_reordering3.h"
 
+static CVarHandle sDisableStarsInterpolationCVar = NULL;
+
 #include "water_effect.inc"
 
 #include <libultra/gbi.h>
@@ -252,7 +254,7 @@ void Background_DrawStarfield(void) {
         zCos = __cosf(gStarfieldRoll);
         zSin = __sinf(gStarfieldRoll);
 
-        if (CVarGetInteger("gDisableStarsInterpolation", 0) == 1) {
+        if (CVarGetCachedInteger(&sDisableStarsInterpolationCVar, "gDisableStarsInterpolation", 0) == 1) {
             FrameInterpolation_ShouldInterpolateFrame(false);
         }
 
@@ -344,7 +346,7 @@ void Background_DrawStarfield(void) {
             }
         }
 
-        if (CVarGetInteger("gDisableStarsInterpolation", 0) == 1) {
+        if (CVarGetCachedInteger(&sDisableStarsInterpolationCVar, "gDisableStarsInterpolation", 0) == 1) {
             FrameInterpolation_ShouldInterpolateFrame(true);
         }
     }
@@ -9,6 +9,8 @@
 #include "port/hooks/list/EngineEvent.h"
 #include "port/mods/PortEnhancements.h"
 
+static CVarHandle sCockpitOpacityCVar = NULL;
+
 // f32 path1 = 0.0f;
 // f32 path2 = 0.0f;
 
@@ -718,7 +720,7 @@ void Display_CockpitGlass(void) {
     Matrix_Scale(gGfxMatrix, D_display_800CA28C, D_display_800CA28C, D_display_800CA28C, MTXF_APPLY);
     Matrix_SetGfxMtx(&gMasterDisp);
     RCP_SetupDL_64_2();
-    u16 opacity = CVarGetInteger("gCockpitOpacity", 120);
+    u16 opacity = CVarGetCachedInteger(&sCockpitOpacityCVar, "gCockpitOpacity", 120);
     gDPSetPrimColor(gMasterDisp++, 0x00, 0x00, 255, 255, 255, opacity);
     gSPClearGeometryMode(gMasterDisp++, G_CULL_BACK);
     gSPDisplayList(gMasterDisp++, D_arwing_30194E0);
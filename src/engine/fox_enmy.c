@@ -19,6 +19,9 @@
 #include "assets/ast_versus.h"
 #include "assets/ast_zoness.h"
 #include "port/hooks/Events.h"
+#include "port/effects/ParallelEffects.h"
+
+static CVarHandle sRapidFireCVar = NULL;
 
 s32 D_enmy_Timer_80161670[4];
 s32 gLastPathChange;
@@ -92,6 +95,10 @@ void Object_PlayerSfx(f32* pos, u32 sfxId, s32 playerNum) {
 
 void Object_Kill(Object* obj, f32* sfxSrc) {
     obj->status = OBJ_FREE;
+    // @port: Effects simulated on a worker thread stop their sounds when the result is committed.
+    if (ParallelEffects_DeferSfxKill(sfxSrc)) {
+        return;
+    }
     Audio_KillSfxBySource(sfxSrc);
 }
 
@@ -2813,7 +2820,7 @@ void Actor_Update(Actor* this) {
             }
         }
     } else if (this->lockOnTimers[TEAM_ID_FOX] != 0) {
-        bool rapidFire = CVarGetInteger("gRapidFire", 0) == 1;
+        bool rapidFire = CVarGetCachedInteger(&sRapidFireCVar, "gRapidFire", 0) == 1;
         if (!(gControllerHold[gMainController].button & A_BUTTON) ||
             (rapidFire && (gControllerHold[gMainController].button & A_BUTTON))) {
             this->lockOnTimers[TEAM_ID_FOX]--;
@@ -3018,6 +3025,10 @@ void Effect_Update(Effect* this) {
         }
         case OBJ_ACTIVE: {
             CALL_CANCELLABLE_EVENT(ObjectUpdateEvent, OBJECT_TYPE_EFFECT, this) {
+                // @port: Use the result simulated ahead of time on a worker thread when it is still valid.
+                if (ParallelEffects_Commit(this)) {
+                    break;
+                }
                 Effect_Move(this);
                 if ((this->obj.status != OBJ_FREE) && (this->info.action != NULL)) {
                     this->info.action(&this->obj);
@@ -3028,6 +3039,36 @@ void Effect_Update(Effect* this) {
     }
 }
 
+// @port: Effect updates that only touch the effect itself and read globals nothing changes during the effect loop.
+// These can be simulated off the main thread, see ParallelEffects.cpp.
+static ObjectFunc sIsolatedEffectActions[] = {
+    (ObjectFunc) Effect_Effect342_Update, (ObjectFunc) Effect_Effect343_Update, (ObjectFunc) Effect_Effect345_Update,
+    (ObjectFunc) Effect_Effect346_Update, (ObjectFunc) Effect_Clouds_Update,    (ObjectFunc) Effect_Effect351_Update,
+    (ObjectFunc) Effect_Effect359_Update, (ObjectFunc) Effect_Effect361_Update, (ObjectFunc) Effect_Effect364_Update,
+    (ObjectFunc) Effect_Effect365_Update, (ObjectFunc) Effect_Effect367_Update, (ObjectFunc) Effect_Effect372_Update,
+    (ObjectFunc) Effect_Effect375_Update, (ObjectFunc) Effect_Effect381_Update, (ObjectFunc) Effect_Effect384_Update,
+    (ObjectFunc) Effect_Effect385_Update, (ObjectFunc) Effect_TimedSfx_Update,
+};
+
+bool Effect_IsIsolated(Effect* this) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(sIsolatedEffectActions); i++) {
+        if (this->info.action == sIsolatedEffectActions[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// @port: The OBJ_ACTIVE path of Effect_Update without the update event, run on a copy of the effect.
+void Effect_UpdateIsolated(Effect* this) {
+    Effect_Move(this);
+    if ((this->obj.status != OBJ_FREE) && (this->info.action != NULL)) {
+        this->info.action(&this->obj);
+    }
+}
+
 void TexturedLine_Update(TexturedLine* this) {
     Vec3f sp44;
     Vec3f sp38;
@@ -3167,6 +3208,9 @@ void Object_Update(void) {
         }
     }
 
+    // @port: Simulate isolated effects on worker threads, Effect_Update commits them in slot order.
+    ParallelEffects_Simulate();
+
     for (i = 0, effect = &gEffects[0]; i < ARRAY_COUNT(gEffects); i++, effect++) {
         if (effect->obj.status != OBJ_FREE) {
             effect->index = i;
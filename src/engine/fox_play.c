@@ -22,6 +22,7 @@
 #include "assets/ast_area_6.h"
 #include "assets/ast_zoness.h"
 #include "port/hooks/Events.h"
+#include "port/resource/LevelManifest.h"
 
 extern float gCurrentScreenWidth;
 extern float gCurrentScreenHeight;
@@ -30,6 +31,12 @@ extern Vtx D_SO_6004500_copy[];
 extern Vtx D_ZO_6009ED0_copy[];
 extern Vtx D_ZO_600C780_copy[];
 
+static CVarHandle sInvincibleCVar = NULL;
+static CVarHandle sUnbreakableWingsCVar = NULL;
+static CVarHandle sRapidFireCVar = NULL;
+static CVarHandle sLtoChargeCVar = NULL;
+static CVarHandle sInvertYAxisCVar = NULL;
+
 UNK_TYPE D_800D2F50 = 0; // unused
 s32 sOverheadCam = 0;
 f32 sOverheadCamDist = 0.0f;
@@ -527,6 +534,8 @@ void Play_Setup360_AND(void) {
 void Play_Setup(void) {
     s32 i;
 
+    LevelManifest_EnterLevel(gCurrentLevel);
+
     gStarCount = 0;
     gLevelPhase = 0;
     gMissedZoSearchlight = false;
@@ -935,7 +944,7 @@ void Player_DamageWings(Player* player, s32 side, s32 damage) {
             gRightWingFlashTimer[player->num] = 30;
             if (player->arwing.rightWingState == WINGSTATE_INTACT) {
                 gRightWingHealth[player->num] -= damage;
-                if (CVarGetInteger("gUnbreakableWings", 0) == 0) {
+                if (CVarGetCachedInteger(&sUnbreakableWingsCVar, "gUnbreakableWings", 0) == 0) {
                     if (gRightWingHealth[player->num] <= 0) {
                         Play_SpawnDebris(1, player->hit1.x, player->hit1.y, player->hit1.z);
                         player->arwing.rightWingState = WINGSTATE_BROKEN;
@@ -952,7 +961,7 @@ void Player_DamageWings(Player* player, s32 side, s32 damage) {
             gLeftWingFlashTimer[player->num] = 30;
             if (player->arwing.leftWingState == WINGSTATE_INTACT) {
                 gLeftWingHealth[player->num] -= damage;
-                if (CVarGetInteger("gUnbreakableWings", 0) == 0) {
+                if (CVarGetCachedInteger(&sUnbreakableWingsCVar, "gUnbreakableWings", 0) == 0) {
                     if (gLeftWingHealth[player->num] <= 0) {
                         Play_SpawnDebris(0, player->hit2.x, player->hit2.y, player->hit2.z);
                         player->arwing.leftWingState = WINGSTATE_BROKEN;
@@ -974,7 +983,7 @@ void Player_ApplyDamage(Player* player, s32 direction, s32 damage) {
     Vec3f sp38;
     f32 sp34 = 20.0f;
 
-    if (CVarGetInteger("gInvincible", 0)) {
+    if (CVarGetCachedInteger(&sInvincibleCVar, "gInvincible", 0)) {
         damage = 0;
     }
 
@@ -3328,10 +3337,10 @@ bool Player_UpdateLockOn(Player* player) {
     bool hasBombTarget;
     s32 i;
 
-    bool rapidFire = CVarGetInteger("gRapidFire", 0) == 1;
+    bool rapidFire = CVarGetCachedInteger(&sRapidFireCVar, "gRapidFire", 0) == 1;
     bool charging;
     if (rapidFire) {
-        if (CVarGetInteger("gLtoCharge", 0) == 1) {
+        if (CVarGetCachedInteger(&sLtoChargeCVar, "gLtoCharge", 0) == 1) {
             charging = (gInputHold->button & L_TRIG) && !(gInputHold->button & A_BUTTON);
         } else {
             charging = !(gInputHold->button & A_BUTTON);
@@ -3370,7 +3379,7 @@ bool Player_UpdateLockOn(Player* player) {
         }
     }
 
-    if (gInputPress->button & (CVarGetInteger("gLtoCharge", 0) == 1 ? L_TRIG : A_BUTTON)) {
+    if (gInputPress->button & (CVarGetCachedInteger(&sLtoChargeCVar, "gLtoCharge", 0) == 1 ? L_TRIG : A_BUTTON)) {
         for (i = 0; i < ARRAY_COUNT(gActors); i++) {
             if ((gActors[i].obj.status == OBJ_ACTIVE) && (gActors[i].lockOnTimers[player->num] != 0)) {
                 if ((gPlayerShots[14 - player->num].obj.status == SHOT_FREE) ||
@@ -3456,7 +3465,7 @@ bool Player_UpdateLockOn(Player* player) {
 }
 
 void Player_Shoot(Player* player) {
-    bool rapidFire = CVarGetInteger("gRapidFire", 0) == 1;
+    bool rapidFire = CVarGetCachedInteger(&sRapidFireCVar, "gRapidFire", 0) == 1;
 
     switch (player->form) {
         case FORM_ARWING:
@@ -3757,7 +3766,7 @@ void Player_MoveArwing360(Player* player) {
 
     sp7C = -gInputPress->stick_x;
 
-    sp78 = gInputPress->stick_y * (CVarGetInteger("gInvertYAxis", 0) == 1 ? -1 : 1);
+    sp78 = gInputPress->stick_y * (CVarGetCachedInteger(&sInvertYAxisCVar, "gInvertYAxis", 0) == 1 ? -1 : 1);
 
     Math_SmoothStepToAngle(&player->aerobaticPitch, 0.0f, 0.1f, 5.0f, 0.01f);
     Matrix_RotateZ(gCalcMatrix, -player->zRotBank * M_DTOR, MTXF_NEW);
@@ -4003,7 +4012,7 @@ void Player_MoveArwingOnRails(Player* player) {
     }
 
     stickX = -gInputPress->stick_x;
-    stickY = gInputPress->stick_y * (CVarGetInteger("gInvertYAxis", 0) == 1 ? -1 : 1);
+    stickY = gInputPress->stick_y * (CVarGetCachedInteger(&sInvertYAxisCVar, "gInvertYAxis", 0) == 1 ? -1 : 1);
 
     Math_SmoothStepToAngle(&player->aerobaticPitch, 0.0f, 0.1f, 5.0f, 0.01f);
 
@@ -5626,7 +5635,7 @@ void Player_UpdateShields(Player* player) {
         if (player->damage <= 0) {
             player->damage = 0;
         }
-        if (!CVarGetInteger("gInvincible", 0)) {
+        if (!CVarGetCachedInteger(&sInvincibleCVar, "gInvincible", 0)) {
             player->shields -= 2;
         }
         if (player->shields <= 0) {
@@ -6948,7 +6957,7 @@ void Play_UpdateLevel(void) {
             }
 
             if ((gPlayer[0].state == PLAYERSTATE_ACTIVE) && ((gGameFrameCount & cycleMask) == 0)) {
-                if (!CVarGetInteger("gInvincible", 0)) {
+                if (!CVarGetCachedInteger(&sInvincibleCVar, "gInvincible", 0)) {
                     gPlayer[0].shields--;
                 }
                 if (gPlayer[0].shields <= 0) {
@@ -1,6 +1,7 @@
 #include "global.h"
 #include "assets/ast_text.h"
 #include "sf64_tagging.h"
+#include "port/anim/AnimationCache.h"
 
 char D_801619A0[100];
 
@@ -347,9 +348,17 @@ s16 Animation_GetFrameData(Animation* animationSegmemt, s32 frame, Vec3f* frameT
     u16 limbCount = animation->limbCount;
     JointKey* key = SEGMENTED_TO_VIRTUAL(animation->jointKey);
     u16* frameData = SEGMENTED_TO_VIRTUAL(animation->frameData);
+    Vec3f* frameTableStart = frameTable;
+    s16 cachedCount;
     s32 i;
     s32 temp;
 
+    // @port: Squadrons share (animation, frame) pairs, reuse the pose already decoded this frame.
+    cachedCount = AnimationCache_LoadPose(animation, frame, frameTable);
+    if (cachedCount != 0) {
+        return cachedCount;
+    }
+
     temp = (frame < key->xLen) ? frameData[key->x + frame] : frameData[key->x];
     frameTable->x = (s16) temp;
     temp = (frame < key->yLen) ? frameData[key->y + frame] : frameData[key->y];
@@ -366,6 +375,8 @@ s16 Animation_GetFrameData(Animation* animationSegmemt, s32 frame, Vec3f* frameT
         temp = (frame < key->zLen) ? frameData[key->z + frame] : frameData[key->z];
         frameTable->z = temp * 360.0f / 65536.0f;
     }
+
+    AnimationCache_StorePose(animation, frame, frameTableStart, limbCount + 1);
     return limbCount + 1;
 }
 
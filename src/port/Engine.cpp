@@ -38,6 +38,12 @@
 #include "resource/importers/audio/SoundFontFactory.h"
 
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/anim/AnimationCache.h"
+#include "port/resource/ArchiveBenchmark.h"
+#include "port/audio/MixerCommands.h"
+#include "port/audio/AudioRender.h"
+#include "port/audio/SampleCache.h"
+#include "libultraship/src/resource/archive/ArchiveCompression.h"
 #include <Fast3D/Fast3dWindow.h>
 #include <DisplayListFactory.h>
 #include <TextureFactory.h>
@@ -49,6 +55,7 @@
 #include "port/mods/PortEnhancements.h"
 
 #include <Fast3D/interpreter.h>
+#include <algorithm>
 #include <filesystem>
 
 #ifdef __SWITCH__
@@ -137,6 +144,7 @@ GameEngine::GameEngine() {
     SPDLOG_INFO("[iOS] Looking for assets O2R at: {}", assets_path);
 #else
     const std::string main_path = Ship::Context::GetPathRelativeToAppDirectory("sf64.o2r");
+    const std::string mapped_path = Ship::Context::GetPathRelativeToAppDirectory("sf64.o2m");
     const std::string assets_path = Ship::Context::LocateFileAcrossAppDirs("starship.o2r");
 #endif
     std::vector<std::string> archiveFiles;
@@ -203,6 +211,7 @@ GameEngine::GameEngine() {
             // Generated O2R will be in Documents directory
             const std::string docs_main_path = Ship::Context::GetPathRelativeToAppDirectory("sf64.o2r");
             if (std::filesystem::exists(docs_main_path)) {
+                CompressAssetFile(docs_main_path);
                 archiveFiles.push_back(docs_main_path);
                 SPDLOG_INFO("[iOS] Successfully generated and added O2R file");
             } else {
@@ -213,7 +222,12 @@ GameEngine::GameEngine() {
     }
 #else
 
-    if (std::filesystem::exists(main_path)) {
+    // A memory-mapped copy made by archive_convert is used unless sf64.o2r was regenerated after it
+    if (std::filesystem::exists(mapped_path) &&
+        (!std::filesystem::exists(main_path) ||
+         std::filesystem::last_write_time(mapped_path) >= std::filesystem::last_write_time(main_path))) {
+        archiveFiles.push_back(mapped_path);
+    } else if (std::filesystem::exists(main_path)) {
         archiveFiles.push_back(main_path);
     } else {
         if (ShowYesNoBox("No O2R Files", "No O2R files found. Generate one now?") == IDYES) {
@@ -221,6 +235,7 @@ GameEngine::GameEngine() {
                 ShowMessage("Error", "An error occured, no O2R file was generated.\n\nExiting...");
                 exit(1);
             } else {
+                CompressAssetFile(main_path);
                 archiveFiles.push_back(main_path);
             }
         } else {
@@ -256,7 +271,8 @@ GameEngine::GameEngine() {
         if (std::filesystem::is_directory(patches_path)) {
             for (const auto& p : std::filesystem::recursive_directory_iterator(patches_path)) {
                 auto ext = p.path().extension().string();
-                if (StringHelper::IEquals(ext, ".zip") || StringHelper::IEquals(ext, ".o2r")) {
+                if (StringHelper::IEquals(ext, ".zip") || StringHelper::IEquals(ext, ".o2r") ||
+                    StringHelper::IEquals(ext, ".o2m")) {
                     archiveFiles.push_back(p.path().generic_string());
                 }
             }
@@ -306,7 +322,10 @@ GameEngine::GameEngine() {
     auto window = std::make_shared<Fast::Fast3dWindow>(std::vector<std::shared_ptr<Ship::GuiWindow>>({}));
 
     auto audioChannelsSetting = Ship::Context::GetInstance()->GetConfig()->GetCurrentAudioChannelsSetting();
-    this->context->Init(archiveFiles, {}, 3, { 32000, 1024, 1680, audioChannelsSetting }, window, controlDeck);
+    // The synthesis runs at the player's rate, 48 kHz is what most devices mix at and spares their resampling
+    const int32_t audioSampleRate = CVarGetInteger("gAudioOutput48kHz", 0) ? 48000 : 32000;
+    this->context->Init(archiveFiles, {}, 3, { audioSampleRate, 1024, 1680, audioChannelsSetting }, window,
+                        controlDeck);
 
 #ifndef __SWITCH__
     Ship::Context::GetInstance()->GetLogger()->set_level(
@@ -398,13 +417,82 @@ GameEngine::GameEngine() {
     loader->RegisterResourceFactory(std::make_shared<SF64::ResourceFactoryXMLSoundFontV0>(), RESOURCE_FORMAT_XML,
                                     "SoundFont", static_cast<uint32_t>(SF64::ResourceType::SoundFont), 0);
 
+    // The audio thread keeps raw pointers into sound data for as long as a sequence plays, so it is never unloaded
+    for (auto type : { SF64::ResourceType::Bank, SF64::ResourceType::Sample, SF64::ResourceType::Sequence,
+                       SF64::ResourceType::SoundFont, SF64::ResourceType::Drum, SF64::ResourceType::Instrument,
+                       SF64::ResourceType::AdpcmLoop, SF64::ResourceType::AdpcmBook, SF64::ResourceType::Envelope,
+                       SF64::ResourceType::AudioTable }) {
+        context->GetResourceManager()->SetResourceTypePinned(static_cast<uint32_t>(type), true);
+    }
+
+    // The renderer's texture cache is keyed by image address, which a texture loaded after an unload can reuse
+    context->GetResourceManager()->SetEvictionCallback([](const std::shared_ptr<Ship::IResource>& resource) {
+        const auto initData = resource->GetInitData();
+        if (initData != nullptr && initData->Type == static_cast<uint32_t>(Fast::ResourceType::Texture)) {
+            gfx_texture_cache_evict(static_cast<const uint8_t*>(resource->GetRawPointer()));
+        }
+    });
+
     prevAltAssets = CVarGetInteger("gEnhancements.Mods.AlternateAssets", 0);
     gEnableGammaBoost = CVarGetInteger("gGraphics.GammaMode", 0) == 0;
     context->GetResourceManager()->SetAltAssetsEnabled(prevAltAssets);
+
+    context->GetConsole()->AddCommand("archive_benchmark",
+                                      { ArchiveBenchmark_Command,
+                                        "Loads every file of the game archive with 1 to N threads and reports the throughput",
+                                        { { "threads", Ship::ArgumentType::NUMBER, true } } });
+    context->GetConsole()->AddCommand("archive_convert",
+                                      { ArchiveConvert_Command,
+                                        "Writes sf64.o2r as a memory-mapped sf64.o2m that is used from the next start" });
+    context->GetConsole()->AddCommand("archive_compression",
+                                      { ArchiveCompression_Command,
+                                        "Compares size and load time of sf64.o2r compressed with deflate and zstd" });
+    context->GetConsole()->AddCommand("archive_startup",
+                                      { ArchiveStartup_Command,
+                                        "Times opening and loading sf64.o2r and sf64.o2m and reports memory use" });
+    context->GetConsole()->AddCommand("resource_parse",
+                                      { ResourceParse_Command,
+                                        "Times reading and parsing every resource of sf64.o2r" });
+    context->GetConsole()->AddCommand("audio_mixer_verify",
+                                      { AudioMixerVerify_Command,
+                                        "Checks the SIMD audio mixer kernels against the scalar ones on random input",
+                                        { { "iterations", Ship::ArgumentType::NUMBER, true } } });
+    context->GetConsole()->AddCommand("audio_mixer_benchmark",
+                                      { AudioMixerBenchmark_Command,
+                                        "Times the audio envelope mixer and interleave with every supported kernel set",
+                                        { { "notes", Ship::ArgumentType::NUMBER, true },
+                                          { "channels", Ship::ArgumentType::NUMBER, true } } });
+    context->GetConsole()->AddCommand("audio_render",
+                                      { AudioRender_Command,
+                                        "Renders scripted sequences and sound effects to a WAV file without the device",
+                                        { { "file", Ship::ArgumentType::TEXT },
+                                          { "seconds", Ship::ArgumentType::NUMBER },
+                                          { "steps", Ship::ArgumentType::TEXT, true } } });
+}
+
+// The window doesn't exist yet when sf64.o2r is first generated, so progress goes to the log, once a second at most
+static void LogExtractionProgress(const ExtractionProgress& progress) {
+    static const char* sLastStage = nullptr;
+    static std::chrono::steady_clock::time_point sLastLog;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (progress.Stage == sLastStage && progress.Fraction < 1.0f && now - sLastLog < std::chrono::seconds(1)) {
+        return;
+    }
+    sLastStage = progress.Stage;
+    sLastLog = now;
+
+    if (progress.Fraction < 0.0f) {
+        SPDLOG_INFO("[Extractor] {}... {:.0f} s", progress.Stage, progress.ElapsedSeconds);
+    } else {
+        SPDLOG_INFO("[Extractor] {}: {:.0f}% ({:.1f} s)", progress.Stage, progress.Fraction * 100.0f,
+                    progress.ElapsedSeconds);
+    }
 }
 
 bool GameEngine::GenAssetFile(bool exitOnFail) {
     auto extractor = new GameExtractor();
+    extractor->SetProgressCallback(LogExtractionProgress);
 
     if (!extractor->SelectGameFromUI()) {
         ShowMessage("Error", "No ROM selected.\n\nExiting...");
@@ -430,6 +518,21 @@ bool GameEngine::GenAssetFile(bool exitOnFail) {
     return extractor->GenerateOTR();
 }
 
+// The extractor writes deflate entries. Zstd decodes several times faster at a similar size, which is what
+// first-frame loads on handhelds are waiting on, so freshly generated archives are rewritten with it.
+void GameEngine::CompressAssetFile(const std::string& path) {
+    if (!Ship::IsArchiveCompressionSupported(Ship::ArchiveCompression::Zstd)) {
+        SPDLOG_INFO("libzip was built without zstd, keeping {} as deflate", path);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    Ship::RecompressArchive(path, Ship::ArchiveCompression::Zstd, 0, [start](double fraction) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        LogExtractionProgress({ "Compressing assets", (float)fraction, elapsed.count() });
+    });
+}
+
 void GameEngine::Create() {
     const auto instance = Instance = new GameEngine();
     instance->AudioInit();
@@ -489,6 +592,10 @@ void GameEngine::StartFrame() const {
 
 #endif
 
+// Values for 48000 hz
+#define SAMPLES_HIGH_48K 840
+#define SAMPLES_LOW_48K 792
+
 #define MAX_NUM_AUDIO_CHANNELS 6
 
 extern "C" u16 audBuffer = 0;
@@ -501,6 +608,31 @@ extern "C" int countermin = 0;
 extern "C" unsigned short samples_high = SAMPLES_HIGH;
 extern "C" unsigned short samples_low = SAMPLES_LOW;
 
+static CVarHandle sAudioLatencyCVar = nullptr;
+
+// Points the audio player's queue target at the latency set in the audio menu. The player resamples slightly to hold
+// its queue there, and the frame sizes below are picked against the same target.
+static void UpdateAudioLatency() {
+    auto player = Ship::Context::GetInstance()->GetAudio()->GetAudioPlayer();
+    if (player == nullptr) {
+        return;
+    }
+
+    const int32_t latencyMs = CVarGetCachedInteger(&sAudioLatencyCVar, "gAudioLatency", 52);
+    player->SetDesiredBuffered(latencyMs * player->GetSampleRate() / 1000);
+}
+
+// Picks the frame sizes for the rate the synthesis runs at, which AudioHeap_Init sets on every audio reset
+static void UpdateAudioFrameSizes() {
+    if (gAudioBufferParams.samplingFrequency == 48000) {
+        samples_high = SAMPLES_HIGH_48K;
+        samples_low = SAMPLES_LOW_48K;
+    } else {
+        samples_high = SAMPLES_HIGH;
+        samples_low = SAMPLES_LOW;
+    }
+}
+
 void GameEngine::HandleAudioThread() {
 #ifdef PIPE_DEBUG
     std::ofstream outfile("audio.bin", std::ios::binary | std::ios::app);
@@ -522,6 +654,8 @@ void GameEngine::HandleAudioThread() {
 #define MAX_AUDIO_FRAMES_PER_UPDATE 5 // Compile-time constant with max value of gVIsPerFrame
 
         std::unique_lock<std::mutex> Lock(audio.mutex);
+        UpdateAudioLatency();
+        UpdateAudioFrameSizes();
         int samples_left = AudioPlayerBuffered();
         u32 num_audio_samples = samples_left < AudioPlayerGetDesiredBuffered() ? (((samples_high))) : (((samples_low)));
 
@@ -533,7 +667,7 @@ void GameEngine::HandleAudioThread() {
 
         const int32_t num_audio_channels = GetNumAudioChannels();
 
-        s16 audio_buffer[SAMPLES_HIGH * MAX_NUM_AUDIO_CHANNELS * MAX_AUDIO_FRAMES_PER_UPDATE] = { 0 };
+        s16 audio_buffer[SAMPLES_HIGH_48K * MAX_NUM_AUDIO_CHANNELS * MAX_AUDIO_FRAMES_PER_UPDATE] = { 0 };
         for (int i = 0; i < AUDIO_FRAMES_PER_UPDATE; i++) {
             AudioThread_CreateNextAudioBuffer(audio_buffer + i * (num_audio_samples * num_audio_channels),
                                               num_audio_samples);
@@ -613,6 +747,8 @@ void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map
         prevAltAssets = curAltAssets;
         Ship::Context::GetInstance()->GetResourceManager()->SetAltAssetsEnabled(curAltAssets);
         gfx_texture_cache_clear();
+        AnimationCache_Clear();
+        SampleCache_Clear();
     }
 }
 
@@ -817,14 +953,26 @@ extern "C" float COS_DEG(float angle) {
 }
 
 struct TimedEntry {
-    uint64_t duration;
+    uint64_t deadline;
+    uint64_t sequence;
     TimerAction action;
     int32_t* address;
     int32_t value;
-    bool active;
 };
 
+// Orders the heap so the earliest deadline is on top, ties go to the task created first.
+static bool Timer_ExpiresLater(const TimedEntry& a, const TimedEntry& b) {
+    if (a.deadline != b.deadline) {
+        return a.deadline > b.deadline;
+    }
+    return a.sequence > b.sequence;
+}
+
+// Pending tasks only, kept as a min-heap. Finished tasks are popped so their storage gets reused.
 std::vector<TimedEntry> gTimerTasks;
+std::vector<TimedEntry> gExpiredTimerTasks;
+uint64_t gTimerSequence = 0;
+size_t gTimerPeakTasks = 0;
 
 uint64_t Timer_GetCurrentMillis() {
     return SDL_GetTicks();
@@ -833,16 +981,18 @@ uint64_t Timer_GetCurrentMillis() {
 extern "C" s32 Timer_CreateTask(u64 time, TimerAction action, s32* address, s32 value) {
     const auto millis = Timer_GetCurrentMillis();
     TimedEntry entry = {
-        .duration = millis + CYCLES_TO_MSEC_PC(time),
+        .deadline = millis + CYCLES_TO_MSEC_PC(time),
+        .sequence = gTimerSequence++,
         .action = action,
         .address = address,
         .value = value,
-        .active = true,
     };
 
     gTimerTasks.push_back(entry);
+    std::push_heap(gTimerTasks.begin(), gTimerTasks.end(), Timer_ExpiresLater);
+    gTimerPeakTasks = std::max(gTimerPeakTasks, gTimerTasks.size());
 
-    return gTimerTasks.size() - 1;
+    return entry.sequence;
 }
 
 extern "C" void Timer_Increment(int32_t* address, int32_t value) {
@@ -857,7 +1007,6 @@ void Timer_CompleteTask(TimedEntry& task) {
     if (task.action != nullptr) {
         task.action(task.address, task.value);
     }
-    task.active = false;
 }
 
 extern "C" void Timer_Update() {
@@ -868,11 +1017,29 @@ extern "C" void Timer_Update() {
 
     const auto millis = Timer_GetCurrentMillis();
 
-    for (auto& task : gTimerTasks) {
-        if (task.active && millis >= task.duration) {
-            Timer_CompleteTask(task);
-        }
+    // Pop everything that expired first, actions are allowed to create new tasks.
+    while (!gTimerTasks.empty() && millis >= gTimerTasks.front().deadline) {
+        std::pop_heap(gTimerTasks.begin(), gTimerTasks.end(), Timer_ExpiresLater);
+        gExpiredTimerTasks.push_back(gTimerTasks.back());
+        gTimerTasks.pop_back();
+    }
+
+    // Tasks expiring in the same update run in creation order, like they used to.
+    std::sort(gExpiredTimerTasks.begin(), gExpiredTimerTasks.end(),
+              [](const TimedEntry& a, const TimedEntry& b) { return a.sequence < b.sequence; });
+
+    for (auto& task : gExpiredTimerTasks) {
+        Timer_CompleteTask(task);
     }
+    gExpiredTimerTasks.clear();
+}
+
+extern "C" uint32_t Timer_GetLiveTaskCount() {
+    return gTimerTasks.size();
+}
+
+extern "C" uint32_t Timer_GetPeakTaskCount() {
+    return gTimerPeakTasks;
 }
 
 // Gets the width of the main ImGui window
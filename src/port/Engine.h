@@ -1,7 +1,9 @@
 #pragma once
 
-#define LOAD_ASSET(path) (path == NULL ? NULL : (GameEngine_OTRSigCheck((const char*) path) ? ResourceGetDataByName((const char*) path) : path))
-#define LOAD_ASSET_RAW(path) ResourceGetDataByName((const char*) path)
+#include "resource/AssetCache.h"
+
+#define LOAD_ASSET(path) (path == NULL ? NULL : (GameEngine_OTRSigCheck((const char*) path) ? AssetCache_GetData((const char*) path) : path))
+#define LOAD_ASSET_RAW(path) AssetCache_GetData((const char*) path)
 
 typedef enum {
     SF64_VER_US = 0x94F1D5A7,
@@ -31,6 +33,7 @@ class GameEngine {
     GameEngine();
     void StartFrame() const;
     static bool GenAssetFile(bool exitOnFail = true);
+    static void CompressAssetFile(const std::string& path);
     static void Create();
     static void HandleAudioThread();
     static void StartAudioFrame();
@@ -62,6 +65,7 @@ void* GameEngine_Malloc(size_t size);
 bool GameEngine_HasVersion(SF64Version ver);
 void GameEngine_ProcessGfxCommands(Gfx* commands);
 float GameEngine_GetAspectRatio();
+uint32_t GameEngine_GetSampleRate();
 uint8_t GameEngine_OTRSigCheck(const char* imgData);
 uint32_t OTRGetCurrentWidth(void);
 uint32_t OTRGetCurrentHeight(void);
@@ -85,6 +89,8 @@ void* GameEngine_Malloc(size_t size);
 void GameEngine_GetTextureInfo(const char* path, int32_t* width, int32_t* height, float* scale, bool* custom);
 void gDPSetTileSizeInterp(Gfx* pkt, int t, float uls, float ult, float lrs, float lrt);
 uint32_t GameEngine_GetInterpolationFrameCount();
+uint32_t Timer_GetLiveTaskCount();
+uint32_t Timer_GetPeakTaskCount();
 
 #ifdef __cplusplus
 }
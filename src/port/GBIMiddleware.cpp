@@ -7,9 +7,7 @@ extern "C" void gSPDisplayList(Gfx* pkt, Gfx* dl) {
     char* imgData = (char*)dl;
 
     if (GameEngine_OTRSigCheck(imgData) == 1) {
-        auto resource = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(imgData);
-        auto res = std::static_pointer_cast<Fast::DisplayList>(resource);
-        dl = &res->Instructions[0];
+        dl = (Gfx*) AssetCache_GetData(imgData);
         // dl->words.trace.file = imgData;
         // dl->words.trace.idx = 0;
         // dl->words.trace.valid = true;
@@ -30,7 +28,7 @@ extern "C" void gDPSetTileSizeInterp(Gfx* pkt, int t, float uls, float ult, floa
 extern "C" void gSPVertex(Gfx* pkt, uintptr_t v, int n, int v0) {
 
     if (GameEngine_OTRSigCheck((char*)v) == 1) {
-        v = (uintptr_t) ResourceGetDataByName((char *) v);
+        v = (uintptr_t) AssetCache_GetData((char *) v);
     }
 
     __gSPVertex(pkt, v, n, v0);
@@ -40,13 +38,8 @@ extern "C" void gSPInvalidateTexCache(Gfx* pkt, uintptr_t texAddr) {
     char* imgData = (char*)texAddr;
 
     if (texAddr != 0 && GameEngine_OTRSigCheck(imgData) == 1) {
-        auto res = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(imgData);
-
-        if (res->GetInitData()->Type == (uint32_t) Fast::ResourceType::DisplayList)
-            texAddr = (uintptr_t)&((std::static_pointer_cast<Fast::DisplayList>(res))->Instructions[0]);
-        else {
-            texAddr = (uintptr_t) res->GetRawPointer();
-        }
+        // Display lists resolve to &Instructions[0], which is also their raw pointer
+        texAddr = (uintptr_t) AssetCache_GetData(imgData);
     }
    __gSPInvalidateTexCache(pkt, texAddr);
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <Fast3D/interpreter.h>
 #include "Engine.h"
+#include "anim/AnimationCache.h"
+#include "resource/LevelManifest.h"
 
 extern "C" {
 #include <sf64mesg.h>
@@ -22,6 +24,8 @@ void Graphics_PushFrame(Gfx* data) {
 extern "C" void Timer_Update();
 
 void push_frame() {
+    AnimationCache_NewFrame();
+    LevelManifest_Update();
     Graphics_ThreadUpdate();
     GameEngine::StartAudioFrame();
     GameEngine::Instance->StartFrame();
@@ -0,0 +1,94 @@
+#include <libultraship/bridge.h>
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "AnimationCache.h"
+
+/*
+Animation cache.
+
+Enemies in a squadron usually share a skeleton and play the same animation in lockstep,
+so Animation_GetFrameData ends up decoding the same (animation, frame) pair once per
+instance. The decoded joint table only depends on the animation data, so the first
+decode of a frame is kept in an arena and copied out for every other instance.
+
+The pose cache only lives for one game frame, which keeps it safe against resources
+being unloaded or swapped between frames.
+*/
+
+namespace {
+
+struct PoseKey {
+    const Animation* animation;
+    s32 frame;
+
+    bool operator==(const PoseKey& other) const {
+        return animation == other.animation && frame == other.frame;
+    }
+};
+
+struct PoseKeyHash {
+    size_t operator()(const PoseKey& key) const {
+        return std::hash<const void*>()(key.animation) * 31 + static_cast<size_t>(key.frame);
+    }
+};
+
+struct PoseEntry {
+    uint32_t epoch;
+    uint32_t offset;
+    s16 count;
+};
+
+// Distinct poses are bounded by the level's animations, this only guards against long sessions.
+constexpr size_t MAX_POSE_ENTRIES = 4096;
+
+std::unordered_map<PoseKey, PoseEntry, PoseKeyHash> sPoses;
+std::vector<Vec3f> sPoseArena;
+uint32_t sEpoch = 1;
+bool sPoseCacheEnabled = true;
+
+} // namespace
+
+extern "C" void AnimationCache_NewFrame(void) {
+    sEpoch++;
+    sPoseArena.clear();
+    if (sPoses.size() > MAX_POSE_ENTRIES) {
+        sPoses.clear();
+    }
+
+    sPoseCacheEnabled = CVarGetInteger("gPerformance.AnimationPoseCache", 1) != 0;
+}
+
+extern "C" void AnimationCache_Clear(void) {
+    sEpoch++;
+    sPoseArena.clear();
+    sPoses.clear();
+}
+
+extern "C" s16 AnimationCache_LoadPose(Animation* animation, s32 frame, Vec3f* frameTable) {
+    if (!sPoseCacheEnabled) {
+        return 0;
+    }
+
+    auto it = sPoses.find({ animation, frame });
+    if (it == sPoses.end() || it->second.epoch != sEpoch) {
+        return 0;
+    }
+
+    memcpy(frameTable, &sPoseArena[it->second.offset], it->second.count * sizeof(Vec3f));
+    return it->second.count;
+}
+
+extern "C" void AnimationCache_StorePose(Animation* animation, s32 frame, Vec3f* frameTable, s16 count) {
+    if (!sPoseCacheEnabled || count <= 0) {
+        return;
+    }
+
+    PoseEntry& entry = sPoses[{ animation, frame }];
+    entry.epoch = sEpoch;
+    entry.offset = static_cast<uint32_t>(sPoseArena.size());
+    entry.count = count;
+    sPoseArena.insert(sPoseArena.end(), frameTable, frameTable + count);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gfx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Starts a new game frame. Poses decoded during the previous frame are dropped.
+void AnimationCache_NewFrame(void);
+
+// Drops every cached pose, used when the underlying assets can change.
+void AnimationCache_Clear(void);
+
+// Copies the pose decoded earlier this frame for (animation, frame) into frameTable.
+// Returns the number of entries written, or 0 on a miss.
+s16 AnimationCache_LoadPose(Animation* animation, s32 frame, Vec3f* frameTable);
+
+void AnimationCache_StorePose(Animation* animation, s32 frame, Vec3f* frameTable, s16 count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,254 @@
+#include "AudioRender.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include <libultraship/bridge.h>
+#include "StringHelper.h"
+
+extern "C" {
+#include "sf64audio_provisional.h"
+#include "port/resource/loaders/AudioLoader.h"
+void AudioThread_CreateNextAudioBuffer(s16* samples, u32 num_samples);
+uint32_t GameEngine_GetSampleRate();
+extern unsigned short samples_high;
+extern unsigned short samples_low;
+}
+
+/*
+Offline audio rendering.
+
+Runs the audio engine the way a game frame does, Audio_Update followed by one audio update, without
+waiting for the device. Console commands run between audio frames, so the audio thread is idle
+while this drives the engine from the main thread.
+
+Every render starts from a reset audio heap, the random number the game side of the engine draws
+from is seeded per frame, and each update produces the sample count the audio thread would at an
+exact 60 frames per second. The same script therefore gives the same samples on every run, on
+every machine, whatever mixer kernels or threading options are in use. Sound fonts are loaded on the
+spot while rendering instead of on the resource workers, so a sequence starts on the same update
+whether or not its fonts were already cached.
+
+The reset also stops what the game was playing, so the scene's music only returns once the game
+starts it again.
+*/
+
+namespace {
+
+constexpr uint32_t RENDER_FPS = 60;
+constexpr uint32_t MAX_RENDER_SECONDS = 600;
+// The reset has to finish within this many frames, a few are usually enough
+constexpr uint32_t MAX_RESET_FRAMES = 600;
+
+enum class StepType { Bgm, Sfx, Wait };
+
+struct Step {
+    StepType Type;
+    uint32_t Value;
+};
+
+bool ParseStep(const std::string& arg, Step* step) {
+    static const struct {
+        const char* Prefix;
+        StepType Type;
+    } sPrefixes[] = { { "bgm:", StepType::Bgm }, { "sfx:", StepType::Sfx }, { "wait:", StepType::Wait } };
+
+    for (const auto& prefix : sPrefixes) {
+        size_t length = strlen(prefix.Prefix);
+        if (arg.compare(0, length, prefix.Prefix) == 0) {
+            try {
+                step->Type = prefix.Type;
+                step->Value = std::stoul(arg.substr(length), nullptr, 0);
+                return true;
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+void WriteLE(std::ofstream& file, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        file.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+bool WriteWav(const std::string& path, const std::vector<s16>& samples, uint32_t sampleRate, uint32_t channels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    const uint32_t dataSize = static_cast<uint32_t>(samples.size() * sizeof(s16));
+    file.write("RIFF", 4);
+    WriteLE(file, 36 + dataSize, 4);
+    file.write("WAVEfmt ", 8);
+    WriteLE(file, 16, 4);
+    WriteLE(file, 1, 2); // PCM
+    WriteLE(file, channels, 2);
+    WriteLE(file, sampleRate, 4);
+    WriteLE(file, sampleRate * channels * sizeof(s16), 4);
+    WriteLE(file, channels * sizeof(s16), 2);
+    WriteLE(file, 16, 2);
+    file.write("data", 4);
+    WriteLE(file, dataSize, 4);
+    for (s16 sample : samples) {
+        WriteLE(file, static_cast<u16>(sample), 2);
+    }
+    return file.good();
+}
+
+// FNV-1a over the samples as little-endian bytes
+uint64_t Checksum(const std::vector<s16>& samples) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (s16 sample : samples) {
+        for (int i = 0; i < 2; i++) {
+            hash ^= (static_cast<u16>(sample) >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+// Keeps font loads blocking for the length of a render, whichever way it returns
+struct BlockingFontLoads {
+    BlockingFontLoads() {
+        Audio_SetFontLoadBlocking(true);
+    }
+    ~BlockingFontLoads() {
+        Audio_SetFontLoadBlocking(false);
+    }
+};
+
+} // namespace
+
+int32_t AudioRender_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                            std::string* output) {
+    if (args.size() < 3) {
+        if (output) {
+            *output += "Usage: audio_render <file> <seconds> [bgm:<id> | sfx:<id> | wait:<frames>]...";
+        }
+        return 1;
+    }
+
+    uint32_t seconds;
+    try {
+        seconds = std::clamp<uint32_t>(std::stoul(args[2]), 1, MAX_RENDER_SECONDS);
+    } catch (const std::exception&) {
+        if (output) {
+            *output += "Length must be a number of seconds.";
+        }
+        return 1;
+    }
+
+    std::vector<Step> steps;
+    for (size_t i = 3; i < args.size(); i++) {
+        Step step;
+        if (!ParseStep(args[i], &step)) {
+            if (output) {
+                *output += StringHelper::Sprintf("Unknown step '%s'.", args[i].c_str());
+            }
+            return 1;
+        }
+        steps.push_back(step);
+    }
+
+    const uint32_t sampleRate = GameEngine_GetSampleRate();
+    const uint32_t channels = GetNumAudioChannels();
+    if (sampleRate == 0) {
+        if (output) {
+            *output += "No audio player to take the sample rate from.";
+        }
+        return 1;
+    }
+
+    std::vector<s16> frame(samples_high * channels);
+    uint32_t randomSeed = 0x12345678;
+
+    BlockingFontLoads blockingFontLoads;
+    Audio_ResetForRender();
+    uint32_t resetFrames = 0;
+    do {
+        Audio_Update();
+        AudioThread_CreateNextAudioBuffer(frame.data(), samples_low);
+    } while (!Audio_IsResetComplete() && ++resetFrames < MAX_RESET_FRAMES);
+
+    if (!Audio_IsResetComplete()) {
+        if (output) {
+            *output += "The audio engine did not finish resetting.";
+        }
+        return 1;
+    }
+
+    const uint32_t totalFrames = seconds * RENDER_FPS;
+    std::vector<s16> samples;
+    samples.reserve(static_cast<size_t>(seconds) * sampleRate * channels);
+    uint64_t produced = 0;
+    double totalTime = 0.0;
+    double maxTime = 0.0;
+    size_t nextStep = 0;
+    uint32_t waitFrames = 0;
+
+    for (uint32_t i = 0; i < totalFrames; i++) {
+        while (waitFrames == 0 && nextStep < steps.size()) {
+            const Step& step = steps[nextStep++];
+            switch (step.Type) {
+                case StepType::Bgm:
+                    AUDIO_PLAY_BGM(step.Value);
+                    break;
+                case StepType::Sfx:
+                    AUDIO_PLAY_SFX(step.Value, gDefaultSfxSource, 0);
+                    break;
+                case StepType::Wait:
+                    waitFrames = step.Value;
+                    break;
+            }
+        }
+        if (waitFrames != 0) {
+            waitFrames--;
+        }
+
+        // The game side draws from the value the previous update left, which depends on the clock
+        randomSeed = randomSeed * 1664525 + 1013904223;
+        gAudioRandom = randomSeed;
+        Audio_Update();
+
+        // Same frame sizes as the audio thread, picked against an exact clock instead of the device's queue
+        const uint64_t expected = (static_cast<uint64_t>(i) + 1) * sampleRate / RENDER_FPS;
+        const uint32_t count = produced + samples_low >= expected ? samples_low : samples_high;
+
+        auto start = std::chrono::steady_clock::now();
+        AudioThread_CreateNextAudioBuffer(frame.data(), count);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        totalTime += elapsed;
+        maxTime = std::max(maxTime, elapsed);
+        samples.insert(samples.end(), frame.begin(), frame.begin() + count * channels);
+        produced += count;
+    }
+
+    // Leave the engine as clean as it was found, the game restarts its sequences when it needs them
+    Audio_ResetForRender();
+
+    if (!WriteWav(args[1], samples, sampleRate, channels)) {
+        if (output) {
+            *output += StringHelper::Sprintf("Could not write %s.", args[1].c_str());
+        }
+        return 1;
+    }
+
+    if (output) {
+        const double frameBudget = 1.0 / RENDER_FPS;
+        *output += StringHelper::Sprintf(
+            "Wrote %llu samples of %u channels at %u Hz to %s\n"
+            "Synthesis: %.1f us per update on average, %.1f us at most (%.1f%% of a frame)\n"
+            "Checksum: %016llx",
+            static_cast<unsigned long long>(produced), channels, sampleRate, args[1].c_str(),
+            totalTime / totalFrames * 1e6, maxTime * 1e6, totalTime / totalFrames / frameBudget * 100.0,
+            static_cast<unsigned long long>(Checksum(samples)));
+    }
+    return 0;
+}
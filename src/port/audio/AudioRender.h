@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ship {
+class Console;
+}
+
+// Console command: audio_render <file> <seconds> [bgm:<id> | sfx:<id> | wait:<frames>]...
+// Resets the audio engine, plays the scripted sequences and sound effects through the synthesis pipeline as fast as
+// it goes, and writes the output to a WAV file. Reports the synthesis time per audio update and a checksum of the
+// samples, which stays the same across changes that must not alter the output.
+int32_t AudioRender_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                            std::string* output);
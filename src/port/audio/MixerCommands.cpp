@@ -0,0 +1,74 @@
+#include "MixerCommands.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "StringHelper.h"
+
+extern "C" {
+#include "audio/mixer.h"
+}
+
+int32_t AudioMixerVerify_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                 std::string* output) {
+    uint32_t iterations = 1000;
+    if (args.size() > 1) {
+        try {
+            iterations = std::clamp<uint32_t>(std::stoul(args[1]), 1, 1000000);
+        } catch (const std::exception&) {
+            if (output) {
+                *output += "Iteration count must be a number.";
+            }
+            return 1;
+        }
+    }
+
+    std::string report = StringHelper::Sprintf("Active mixer kernels: %s\n", Mixer_GetKernelsName());
+    uint32_t seed = static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    uint32_t mismatches = Mixer_VerifyKernels(
+        iterations, seed,
+        [](void* userData, const char* line) {
+            *static_cast<std::string*>(userData) += std::string(line) + "\n";
+        },
+        &report);
+
+    report += StringHelper::Sprintf("Seed %u, %u mismatching runs", seed, mismatches);
+    if (output) {
+        *output += report;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+int32_t AudioMixerBenchmark_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                    std::string* output) {
+    uint32_t notes = 24;
+    uint32_t channels = 6;
+    try {
+        if (args.size() > 1) {
+            notes = std::clamp<uint32_t>(std::stoul(args[1]), 1, 256);
+        }
+        if (args.size() > 2) {
+            channels = std::stoul(args[2]) == 2 ? 2 : 6;
+        }
+    } catch (const std::exception&) {
+        if (output) {
+            *output += "Note and channel counts must be numbers.";
+        }
+        return 1;
+    }
+
+    std::string report = StringHelper::Sprintf("%u notes, %u channels, active mixer kernels: %s\n", notes, channels,
+                                               Mixer_GetKernelsName());
+    Mixer_BenchmarkKernels(
+        notes, 500, channels,
+        []() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); },
+        [](void* userData, const char* line) {
+            *static_cast<std::string*>(userData) += std::string(line) + "\n";
+        },
+        &report);
+
+    if (output) {
+        *output += report;
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ship {
+class Console;
+}
+
+// Console command: audio_mixer_verify [iterations]
+// Runs every SIMD mixer kernel the CPU supports against the scalar reference on random input, and reports the
+// active kernel set and the number of runs of each kernel whose output differs.
+int32_t AudioMixerVerify_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                 std::string* output);
+
+// Console command: audio_mixer_benchmark [notes] [channels]
+// Times the envelope mixer and channel interleave of an audio update with every mixer kernel set the CPU supports,
+// and reports the cost per note and per update of each.
+int32_t AudioMixerBenchmark_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                    std::string* output);
@@ -0,0 +1,123 @@
+#include <libultraship/bridge.h>
+#include <BS_thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <thread>
+
+#include "ParallelSynthesis.h"
+
+extern "C" {
+#include "sf64audio_provisional.h"
+#include "audio/mixer.h"
+bool AudioSynth_IsNoteIsolated(s32 noteIndex, s32 updateIndex);
+void AudioSynth_ResolveNoteCVars(void);
+void AudioSynth_ProcessIsolatedNote(s32 noteIndex, s32 aiBufLen, s32 updateIndex, s16* dry, s16* wet);
+void AudioSynth_MixIsolatedNote(const s16* dry, const s16* wet);
+}
+
+/*
+Parallel note synthesis.
+
+AudioSynth_DoOneAudioUpdate runs AudioSynth_ProcessNote for every playing note in turn, and each
+one decodes, resamples and envelopes its sample before adding it to the shared dry and wet
+channels. Apart from that final add a note only works on its own state and on DMEM scratch space,
+so notes that don't go through the shared sample DMA queue (see AudioSynth_IsNoteIsolated) are
+synthesized on worker threads ahead of the serial loop. Every job runs on the worker's own mixer
+state with silent dry and wet channels and keeps the channels it produced.
+
+The serial loop is left as it is. When it reaches a note that was synthesized ahead of time, the
+kept channels are added to the shared ones with the same clamping add the envelope mixer uses, at
+the same point in the note order the note would have been processed. The reverb loads and saves
+around each group of notes therefore see the same channels, and the output matches the serial
+path sample for sample.
+
+Only stereo output is handled. With 5.1 output the envelope mixer runs the subwoofer channel
+through a low-pass filter whose state carries over from one note to the next, so those updates
+stay serial.
+*/
+
+namespace {
+
+struct NoteJob {
+    s16 dry[DMEM_2CH_SIZE / sizeof(s16)];
+    s16 wet[DMEM_2CH_SIZE / sizeof(s16)];
+    bool pending;
+};
+
+struct WorkerState {
+    MixerState* state = Mixer_CreateState();
+
+    ~WorkerState() {
+        Mixer_DestroyState(state);
+    }
+};
+
+// Below this many isolated notes the dispatch costs more than it saves.
+constexpr size_t MIN_PARALLEL_NOTES = 8;
+constexpr size_t MAX_SYNTHESIS_WORKERS = 4;
+// The size of the note order in AudioSynth_DoOneAudioUpdate
+constexpr size_t MAX_NOTES = 0x3C;
+
+std::array<NoteJob, MAX_NOTES> sJobs;
+std::array<uint8_t, MAX_NOTES> sQueue;
+std::unique_ptr<BS::thread_pool> sPool;
+thread_local WorkerState sWorkerState;
+CVarHandle sEnabledCVar = nullptr;
+
+void RunJob(uint8_t noteIndex, s32 aiBufLen, s32 updateIndex) {
+    NoteJob& job = sJobs[noteIndex];
+
+    MixerState* previous = Mixer_SetState(sWorkerState.state);
+    AudioSynth_ProcessIsolatedNote(noteIndex, aiBufLen, updateIndex, job.dry, job.wet);
+    Mixer_SetState(previous);
+}
+
+} // namespace
+
+extern "C" void ParallelSynthesis_Process(const uint8_t* notes, int32_t count, int32_t aiBufLen,
+                                          int32_t updateIndex) {
+    size_t queued = 0;
+
+    for (auto& job : sJobs) {
+        job.pending = false;
+    }
+
+    if (!CVarGetCachedInteger(&sEnabledCVar, "gPerformance.ParallelAudio", 0) || (GetNumAudioChannels() != 2)) {
+        return;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        if ((notes[i] < MAX_NOTES) && AudioSynth_IsNoteIsolated(notes[i], updateIndex)) {
+            sQueue[queued++] = notes[i];
+        }
+    }
+
+    if (queued < MIN_PARALLEL_NOTES) {
+        return;
+    }
+
+    if (sPool == nullptr) {
+        size_t workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, MAX_SYNTHESIS_WORKERS + 1) - 1;
+        sPool = std::make_unique<BS::thread_pool>(workers);
+    }
+
+    AudioSynth_ResolveNoteCVars();
+    sPool->submit_loop<size_t>(0, queued, [=](size_t i) { RunJob(sQueue[i], aiBufLen, updateIndex); }).wait();
+
+    for (size_t i = 0; i < queued; i++) {
+        sJobs[sQueue[i]].pending = true;
+    }
+}
+
+extern "C" bool ParallelSynthesis_Commit(int32_t noteIndex) {
+    if ((noteIndex < 0) || (static_cast<size_t>(noteIndex) >= MAX_NOTES) || !sJobs[noteIndex].pending) {
+        return false;
+    }
+
+    NoteJob& job = sJobs[noteIndex];
+    job.pending = false;
+    AudioSynth_MixIsolatedNote(job.dry, job.wet);
+    return true;
+}
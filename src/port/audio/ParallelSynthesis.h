@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Synthesizes the isolated notes among the count notes of the update on worker threads, each into a mixer state of
+// its own. The mixes are kept aside until AudioSynth_DoOneAudioUpdate reaches each note.
+void ParallelSynthesis_Process(const uint8_t* notes, int32_t count, int32_t aiBufLen, int32_t updateIndex);
+
+// Called from AudioSynth_DoOneAudioUpdate at the note's turn. Returns true when the note was synthesized ahead of
+// time and its mix has been added to the output, in which case it must not be processed again.
+bool ParallelSynthesis_Commit(int32_t noteIndex);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,289 @@
+#include <libultraship/bridge.h>
+#include <BS_thread_pool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "SampleCache.h"
+
+extern "C" {
+#include "audio/mixer.h"
+}
+
+/*
+Decoded sample cache.
+
+Every playing note decodes its ADPCM data again on every audio update, even the short sound effects
+that are started many times a minute. Samples that are small, or started often, are decoded once into
+a pool, and aADPCMdec is replaced by a copy of the frames it would have produced.
+
+A frame only depends on its data, the book and the last two samples before it. A sample is decoded
+from the start with the decoder's initial silence, and for looping samples again from the loop's
+predictor state, which is what a note continues from after jumping back. A copy is only made when the
+samples the decoder would continue from match the ones in front of the cached frames, so the output
+is the same as decoding, bit for bit, whatever path the note took to get there. Anything else is
+decoded as before. Notes can pick another book for the same sample, so the book is part of the key.
+
+Entries are keyed by the sample header and checked against its data pointer and size, the alt assets
+toggle clears the pool. Decoded samples are evicted least recently used first once the pool is full.
+
+A sample can take milliseconds to decode, so it is decoded on a worker thread of its own and only put
+in the pool once it is done. The audio thread, and the synthesis workers, keep decoding it as usual
+until then, and only hold the lock to look an entry up.
+*/
+
+namespace {
+
+// Decoded on their first start, about two seconds at 32 kHz
+constexpr size_t SMALL_SAMPLE_BYTES = 128 * 1024;
+// Larger samples are decoded once they have been started this often
+constexpr uint32_t FREQUENT_STARTS = 4;
+constexpr size_t MAX_SAMPLE_BYTES = 2 * 1024 * 1024;
+constexpr size_t MAX_POOL_BYTES = 32 * 1024 * 1024;
+
+constexpr uint32_t SAMPLES_PER_ADPCM_FRAME = 16;
+constexpr uint32_t ADPCM_FRAME_BYTES = 9;
+
+struct DecodedSample {
+    // The silence the decoder starts from, then every frame decoded from the start
+    std::vector<s16> Frames;
+    // The loop's predictor state, then the frames after it decoded from that state. Empty when these are the same
+    // as the ones decoded from the start.
+    std::vector<s16> LoopFrames;
+    uint32_t NumFrames;
+    uint32_t LoopFrame;
+
+    size_t Bytes() const {
+        return (Frames.size() + LoopFrames.size()) * sizeof(s16);
+    }
+};
+
+struct EntryKey {
+    const Sample* sample;
+    const s16* book;
+
+    bool operator==(const EntryKey& other) const {
+        return sample == other.sample && book == other.book;
+    }
+};
+
+struct EntryKeyHash {
+    size_t operator()(const EntryKey& key) const {
+        return std::hash<const void*>()(key.sample) * 31 + std::hash<const void*>()(key.book);
+    }
+};
+
+struct Entry {
+    const u8* SampleAddr = nullptr;
+    u32 Size = 0;
+    u32 NumEntries = 0;
+    uint32_t Starts = 0;
+    uint64_t LastUse = 0;
+    bool Decoding = false;
+    std::shared_ptr<const DecodedSample> Data;
+};
+
+// What the worker needs to decode a sample, the book is copied since notes can load another one meanwhile
+struct DecodeRequest {
+    EntryKey Key;
+    const u8* SampleAddr;
+    u32 Size;
+    AdpcmLoop Loop;
+    std::vector<s16> Book;
+    u32 NumEntries;
+    uint32_t Generation;
+};
+
+std::mutex sMutex;
+std::unordered_map<EntryKey, Entry, EntryKeyHash> sEntries;
+CVarHandle sEnabledCVar = nullptr;
+size_t sPoolBytes = 0;
+uint64_t sClock = 0;
+// Moved by SampleCache_Clear, decodes queued before it are thrown away
+uint32_t sGeneration = 0;
+std::atomic<uint64_t> sHits = 0;
+std::atomic<uint64_t> sMisses = 0;
+// Only used by the decode worker
+MixerState* sDecodeState = nullptr;
+// Declared last so it is destroyed first, waiting for a decode in flight while the pool can still take it
+std::unique_ptr<BS::thread_pool> sDecodePool;
+
+void DecodeFrames(const u8* data, uint32_t firstFrame, uint32_t numFrames, const s16* history,
+                  std::vector<s16>& frames) {
+    ADPCM_STATE state;
+    memcpy(state, history, sizeof(state));
+
+    frames.resize((numFrames - firstFrame + 1) * SAMPLES_PER_ADPCM_FRAME);
+    memcpy(frames.data(), history, sizeof(state));
+    Mixer_DecodeADPCM(data + firstFrame * ADPCM_FRAME_BYTES, numFrames - firstFrame, state,
+                      frames.data() + SAMPLES_PER_ADPCM_FRAME);
+}
+
+std::shared_ptr<const DecodedSample> Decode(const DecodeRequest& request) {
+    static const s16 sSilence[SAMPLES_PER_ADPCM_FRAME] = {};
+    auto decoded = std::make_shared<DecodedSample>();
+
+    if (sDecodeState == nullptr) {
+        sDecodeState = Mixer_CreateState();
+    }
+    MixerState* previousState = Mixer_SetState(sDecodeState);
+    aLoadADPCMImpl(request.NumEntries, request.Book.data());
+
+    decoded->NumFrames = request.Size / ADPCM_FRAME_BYTES;
+    decoded->LoopFrame = request.Loop.start / SAMPLES_PER_ADPCM_FRAME;
+    DecodeFrames(request.SampleAddr, 0, decoded->NumFrames, sSilence, decoded->Frames);
+
+    // A note jumping back continues after the frame holding the loop start, from the predictor state
+    const AdpcmLoop& loop = request.Loop;
+    if (loop.count != 0 && decoded->LoopFrame < decoded->NumFrames) {
+        const s16* frame = &decoded->Frames[(decoded->LoopFrame + 1) * SAMPLES_PER_ADPCM_FRAME];
+        if (frame[14] != loop.predictorState[14] || frame[15] != loop.predictorState[15]) {
+            DecodeFrames(request.SampleAddr, decoded->LoopFrame + 1, decoded->NumFrames, loop.predictorState,
+                         decoded->LoopFrames);
+        }
+    }
+
+    Mixer_SetState(previousState);
+    return decoded;
+}
+
+bool ShouldDecode(const Sample* sample, const Entry& entry) {
+    const size_t bytes = (size_t) (sample->size / ADPCM_FRAME_BYTES) * SAMPLES_PER_ADPCM_FRAME * sizeof(s16);
+
+    if (bytes == 0 || bytes > MAX_SAMPLE_BYTES) {
+        return false;
+    }
+    return bytes <= SMALL_SAMPLE_BYTES || entry.Starts >= FREQUENT_STARTS;
+}
+
+void Evict(const Entry* keep) {
+    while (sPoolBytes > MAX_POOL_BYTES) {
+        Entry* oldest = nullptr;
+        for (auto& [key, entry] : sEntries) {
+            if (entry.Data != nullptr && &entry != keep && (oldest == nullptr || entry.LastUse < oldest->LastUse)) {
+                oldest = &entry;
+            }
+        }
+        if (oldest == nullptr) {
+            return;
+        }
+        sPoolBytes -= oldest->Data->Bytes();
+        oldest->Data = nullptr;
+    }
+}
+
+// Puts a decoded sample in the pool, unless its entry was cleared or changed while it was decoding
+void Publish(const DecodeRequest& request, std::shared_ptr<const DecodedSample> decoded) {
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    auto it = sEntries.find(request.Key);
+    if (request.Generation != sGeneration || it == sEntries.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    if (!entry.Decoding || entry.SampleAddr != request.SampleAddr || entry.Size != request.Size ||
+        entry.NumEntries != request.NumEntries) {
+        return;
+    }
+
+    entry.Decoding = false;
+    entry.Data = std::move(decoded);
+    sPoolBytes += entry.Data->Bytes();
+    Evict(&entry);
+}
+
+// Called with sMutex held, only copies what the worker needs
+void QueueDecode(const Sample* sample, const s16* book, u32 nEntries) {
+    DecodeRequest request = { { sample, book }, sample->sampleAddr, sample->size, *sample->loop,
+                              std::vector<s16>(book, book + nEntries / sizeof(s16)), nEntries, sGeneration };
+
+    if (sDecodePool == nullptr) {
+        sDecodePool = std::make_unique<BS::thread_pool>(1);
+    }
+    sDecodePool->detach_task([request = std::move(request)]() { Publish(request, Decode(request)); });
+}
+
+// Returns false when the cache is turned off, decoded is left empty when the sample isn't in the pool
+bool Lookup(Sample* sample, const s16* book, u32 nEntries, bool starting,
+            std::shared_ptr<const DecodedSample>* decoded) {
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    if (!CVarGetCachedInteger(&sEnabledCVar, "gPerformance.SampleCache", 1)) {
+        return false;
+    }
+
+    Entry& entry = sEntries[{ sample, book }];
+    if (entry.SampleAddr != sample->sampleAddr || entry.Size != sample->size || entry.NumEntries != nEntries) {
+        if (entry.Data != nullptr) {
+            sPoolBytes -= entry.Data->Bytes();
+        }
+        entry = Entry();
+        entry.SampleAddr = sample->sampleAddr;
+        entry.Size = sample->size;
+        entry.NumEntries = nEntries;
+    }
+
+    entry.LastUse = ++sClock;
+    if (starting) {
+        entry.Starts++;
+    }
+
+    if (entry.Data == nullptr && !entry.Decoding && ShouldDecode(sample, entry)) {
+        entry.Decoding = true;
+        QueueDecode(sample, book, nEntries);
+    }
+
+    *decoded = entry.Data;
+    return true;
+}
+
+} // namespace
+
+extern "C" bool SampleCache_DecodeADPCM(Sample* sample, const s16* book, u32 nEntries, s32 frameIndex, s32 flags,
+                                        s16* state) {
+    std::shared_ptr<const DecodedSample> decoded;
+    bool copied = false;
+
+    if (!Lookup(sample, book, nEntries, flags & A_INIT, &decoded)) {
+        return false;
+    }
+
+    if (decoded != nullptr && frameIndex >= 0 && (uint32_t) frameIndex < decoded->NumFrames) {
+        const uint32_t frame = frameIndex;
+        const uint32_t available = decoded->NumFrames - frame;
+
+        copied = Mixer_CopyDecodedADPCM(flags, state, &decoded->Frames[frame * SAMPLES_PER_ADPCM_FRAME], available);
+        if (!copied && !decoded->LoopFrames.empty() && frame > decoded->LoopFrame) {
+            copied = Mixer_CopyDecodedADPCM(
+                flags, state, &decoded->LoopFrames[(frame - 1 - decoded->LoopFrame) * SAMPLES_PER_ADPCM_FRAME],
+                available);
+        }
+    }
+
+    (copied ? sHits : sMisses)++;
+    return copied;
+}
+
+extern "C" void SampleCache_Clear(void) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    sEntries.clear();
+    sPoolBytes = 0;
+    sGeneration++;
+}
+
+extern "C" void SampleCache_GetStats(SampleCacheStats* stats) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    stats->Samples = 0;
+    for (const auto& [key, entry] : sEntries) {
+        if (entry.Data != nullptr) {
+            stats->Samples++;
+        }
+    }
+    stats->Bytes = sPoolBytes;
+    stats->Hits = sHits;
+    stats->Misses = sMisses;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sf64audio_provisional.h"
+
+typedef struct {
+    uint32_t Samples;
+    size_t Bytes;
+    uint64_t Hits;
+    uint64_t Misses;
+} SampleCacheStats;
+
+// Called by AudioSynth_ProcessNote in place of an aADPCMdec of the sample's data starting at frameIndex, with the
+// book and nEntries last passed to aLoadADPCM. Writes the same output from the sample's decoded frames and returns
+// true when the sample is in the pool, otherwise the data has to be decoded as usual.
+bool SampleCache_DecodeADPCM(Sample* sample, const s16* book, u32 nEntries, s32 frameIndex, s32 flags, s16* state);
+
+// Drops every decoded sample, used when the underlying assets can change.
+void SampleCache_Clear(void);
+
+void SampleCache_GetStats(SampleCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,147 @@
+#include <libultraship/bridge.h>
+#include <BS_thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+#include "ParallelEffects.h"
+
+extern "C" {
+#include <sf64context.h>
+bool Effect_IsIsolated(Effect* effect);
+void Effect_UpdateIsolated(Effect* effect);
+void Audio_KillSfxBySource(f32* sfxSource);
+}
+
+/*
+Parallel effect simulation.
+
+Explosions, smoke and debris fill gEffects with dozens of effects whose update only touches
+their own fields and reads globals nothing else changes during the effect loop. Those effects
+(see Effect_IsIsolated) are simulated on worker threads on a private copy before the serial loop
+starts.
+
+The serial loop in Object_Update is left as it is. When it reaches a slot, Effect_Update runs its
+update event as usual and then asks for the simulated result. The result is only used if the live
+effect is still byte-identical to the state the worker started from, so anything that touched the
+effect in between (an update listener, another effect killing or reusing the slot) falls back to
+the serial path. Side effects that reach outside the effect, which for isolated effects is only the
+sound teardown in Object_Kill, are recorded by the worker and replayed at commit time. Results
+therefore match the serial update exactly and land in slot order.
+*/
+
+namespace {
+
+struct EffectJob {
+    Effect start;
+    Effect result;
+    f32* sfxKill;
+    bool pending;
+};
+
+// Below this many isolated effects the dispatch costs more than it saves.
+constexpr size_t MIN_PARALLEL_EFFECTS = 16;
+constexpr size_t MAX_EFFECT_WORKERS = 4;
+constexpr size_t EFFECT_COUNT = std::size(gEffects);
+
+std::array<EffectJob, EFFECT_COUNT> sJobs;
+std::array<uint8_t, EFFECT_COUNT> sQueue;
+std::unique_ptr<BS::thread_pool> sPool;
+thread_local EffectJob* sCurrentJob = nullptr;
+
+void RunJob(EffectJob& job) {
+    memcpy(&job.result, &job.start, sizeof(Effect));
+    job.sfxKill = nullptr;
+
+    sCurrentJob = &job;
+    Effect_UpdateIsolated(&job.result);
+    sCurrentJob = nullptr;
+}
+
+} // namespace
+
+extern "C" void ParallelEffects_Simulate(void) {
+    size_t count = 0;
+
+    for (auto& job : sJobs) {
+        job.pending = false;
+    }
+
+    if (!CVarGetInteger("gPerformance.ParallelEffects", 0)) {
+        return;
+    }
+
+    for (size_t i = 0; i < EFFECT_COUNT; i++) {
+        Effect* effect = &gEffects[i];
+
+        if ((effect->obj.status != OBJ_ACTIVE) || !Effect_IsIsolated(effect)) {
+            continue;
+        }
+
+        // Mirror what Object_Update and Effect_Update do before the event fires. Copied bytewise since
+        // the commit compares against it with memcmp.
+        EffectJob& job = sJobs[i];
+        memcpy(&job.start, effect, sizeof(Effect));
+        job.start.index = i;
+        if (job.start.timer_50 != 0) {
+            job.start.timer_50--;
+        }
+        sQueue[count++] = i;
+    }
+
+    if (count < MIN_PARALLEL_EFFECTS) {
+        return;
+    }
+
+    if (sPool == nullptr) {
+        size_t workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, MAX_EFFECT_WORKERS + 1) - 1;
+        sPool = std::make_unique<BS::thread_pool>(workers);
+    }
+
+    sPool->submit_loop<size_t>(0, count, [](size_t i) { RunJob(sJobs[sQueue[i]]); }).wait();
+
+    for (size_t i = 0; i < count; i++) {
+        sJobs[sQueue[i]].pending = true;
+    }
+}
+
+extern "C" bool ParallelEffects_Commit(Effect* effect) {
+    size_t slot = effect - gEffects;
+
+    if (slot >= EFFECT_COUNT || !sJobs[slot].pending) {
+        return false;
+    }
+
+    EffectJob& job = sJobs[slot];
+    job.pending = false;
+
+    if (memcmp(effect, &job.start, sizeof(Effect)) != 0) {
+        return false;
+    }
+
+    memcpy(effect, &job.result, sizeof(Effect));
+
+    if (job.sfxKill != nullptr) {
+        // Sources inside the effect pointed at the worker's copy, point them back at the live effect.
+        uintptr_t offset = reinterpret_cast<uintptr_t>(job.sfxKill) - reinterpret_cast<uintptr_t>(&job.result);
+        if (offset < sizeof(Effect)) {
+            Audio_KillSfxBySource(reinterpret_cast<f32*>(reinterpret_cast<uint8_t*>(effect) + offset));
+        } else {
+            Audio_KillSfxBySource(job.sfxKill);
+        }
+    }
+    return true;
+}
+
+extern "C" bool ParallelEffects_DeferSfxKill(f32* sfxSource) {
+    if (sCurrentJob == nullptr) {
+        return false;
+    }
+
+    sCurrentJob->sfxKill = sfxSource;
+    return true;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "sf64object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Simulates every isolated effect in gEffects on worker threads. Results are kept aside until the
+// serial update loop reaches each slot, so nothing in the live effect table changes here.
+void ParallelEffects_Simulate(void);
+
+// Called from Effect_Update at the slot's turn. Returns true when the simulated result was still
+// valid and has been written back, in which case the serial move/action must be skipped.
+bool ParallelEffects_Commit(Effect* effect);
+
+// Lets Object_Kill hand its sound teardown to the commit step when called from a worker.
+bool ParallelEffects_DeferSfxKill(f32* sfxSource);
+
+#ifdef __cplusplus
+}
+#endif
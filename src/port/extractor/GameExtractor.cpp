@@ -55,13 +55,19 @@ bool GameExtractor::SelectGameFromUI() {
     this->mGamePath = Ship::Context::GetPathRelativeToAppDirectory("baserom.us.rev1.z64");
 #endif
 
-    std::ifstream file(this->mGamePath, std::ios::binary);
+    std::ifstream file(this->mGamePath, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         SPDLOG_ERROR("[Extractor] Failed to open ROM file: {}", this->mGamePath.string());
         return false;
     }
 
-    this->mGameData = std::vector<uint8_t>( std::istreambuf_iterator( file ), {} );
+    // Read in one go, going through a stream iterator costs a call per byte
+    const std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    this->mGameData.resize(size > 0 ? size : 0);
+    if (size > 0 && !file.read(reinterpret_cast<char*>(this->mGameData.data()), size)) {
+        this->mGameData.clear();
+    }
     file.close();
 
     if (this->mGameData.empty()) {
@@ -73,9 +79,9 @@ bool GameExtractor::SelectGameFromUI() {
 }
 
 std::optional<std::string> GameExtractor::ValidateChecksum() const {
-    const auto rom = new N64::Cartridge(this->mGameData);
-    rom->Initialize();
-    auto hash = rom->GetHash();
+    N64::Cartridge rom(this->mGameData);
+    rom.Initialize();
+    auto hash = rom.GetHash();
     
     if (mGameList.find(hash) == mGameList.end()) {
         return std::nullopt;
@@ -84,14 +90,41 @@ std::optional<std::string> GameExtractor::ValidateChecksum() const {
     return mGameList[hash];
 }
 
+void GameExtractor::SetProgressCallback(ExtractionProgressCallback callback) {
+    this->mProgressCallback = std::move(callback);
+}
+
+void GameExtractor::ReportProgress(const char* stage, float fraction,
+                                   std::chrono::steady_clock::time_point start) const {
+    if (!this->mProgressCallback) {
+        return;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    this->mProgressCallback({ stage, fraction, elapsed.count() });
+}
+
 bool GameExtractor::GenerateOTR() const {
     Companion::Instance = new Companion(this->mGameData, ArchiveType::O2R, false);
 
+    // Torch has no progress hook, so the stage only reports its start and end. Its configs are processed one by
+    // one and the archive is written by Torch itself, the time it takes is logged to compare extractions.
+    const auto start = std::chrono::steady_clock::now();
+    ReportProgress("Extracting assets", 0.0f, start);
+
+    bool success = true;
     try {
         Companion::Instance->Init(ExportType::Binary);
     } catch (const std::exception& e) {
-        return false;
+        SPDLOG_ERROR("[Extractor] Extraction failed: {}", e.what());
+        success = false;
     }
 
-    return true;
+    if (success) {
+        ReportProgress("Extracting assets", 1.0f, start);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        SPDLOG_INFO("[Extractor] Extracted assets in {:.1f} s", elapsed.count());
+    }
+
+    return success;
 }
\ No newline at end of file
@@ -1,17 +1,33 @@
 #pragma once
 
 #include "Companion.h"
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include <vector>
 #include <cstdint>
 
+struct ExtractionProgress {
+    const char* Stage;
+    // From 0 to 1, or negative while the stage can't tell how far along it is
+    float Fraction;
+    double ElapsedSeconds;
+};
+
+using ExtractionProgressCallback = std::function<void(const ExtractionProgress&)>;
+
 class GameExtractor {
 public:
     static bool GenAssetFile();
     std::optional<std::string> ValidateChecksum() const;
     bool SelectGameFromUI();
     bool GenerateOTR() const;
+    // Called on the thread running the extraction as each stage starts and finishes, and while one reports progress
+    void SetProgressCallback(ExtractionProgressCallback callback);
 private:
+    void ReportProgress(const char* stage, float fraction, std::chrono::steady_clock::time_point start) const;
+
     fs::path mGamePath;
     std::vector<uint8_t> mGameData;
+    ExtractionProgressCallback mProgressCallback;
 };
\ No newline at end of file
@@ -4,44 +4,140 @@
 
 EventSystem* EventSystem::Instance = new EventSystem();
 
+uint64_t gEventListenerMask[EVENT_MASK_WORDS] = { 0 };
+
+#define LISTENER_SLOT(handle) ((handle) & 0xFFFF)
+#define LISTENER_GENERATION(handle) ((handle) >> 16)
+#define LISTENER_HANDLE(slot, generation) (((ListenerID) (generation) << 16) | (slot))
+
 EventID EventSystem::RegisterEvent() {
+    if (this->mInternalEventID >= MAX_EVENTS) {
+        throw std::runtime_error("Too many events registered");
+    }
+
     return this->mInternalEventID++;
 }
 
 ListenerID EventSystem::RegisterListener(EventID id, EventCallback callback, EventPriority priority) {
-    if(id == -1) {
+    if(id >= this->mInternalEventID) {
         throw std::runtime_error("Trying to register listener for unregistered event");
     }
 
-    auto& listeners = this->mEventListeners[id];
+    auto& event = this->mEventListeners[id];
 
-    if(std::find_if(listeners.begin(), listeners.end(), [callback](EventListener listener) {
-        return listener.function == callback;
-    }) != listeners.end()) {
+    if(std::find_if(event.listeners.begin(), event.listeners.end(), [callback](const RegisteredListener& entry) {
+        return entry.listener.function == callback;
+    }) != event.listeners.end()) {
         throw std::runtime_error("Listener already registered");
     }
 
-    listeners.push_back({ priority, callback });
+    uint16_t slot;
+    if (!this->mFreeListenerSlots.empty()) {
+        slot = this->mFreeListenerSlots.back();
+        this->mFreeListenerSlots.pop_back();
+    } else {
+        if (this->mListenerSlots.size() > 0xFFFF) {
+            throw std::runtime_error("Too many listeners registered");
+        }
+        slot = this->mListenerSlots.size();
+        this->mListenerSlots.push_back({ 0, 0, false });
+    }
+
+    auto& listenerSlot = this->mListenerSlots[slot];
+    listenerSlot.event = id;
+    listenerSlot.used = true;
 
-    // Sort by priority
-    std::sort(listeners.begin(), listeners.end(), [](EventListener a, EventListener b) {
-        return a.priority < b.priority;
-    });
+    ListenerID handle = LISTENER_HANDLE(slot, listenerSlot.generation);
+    event.listeners.push_back({ { priority, callback }, handle });
+
+    // Listeners added while dispatching are sorted in once the dispatch is over
+    if (event.dispatchDepth > 0) {
+        event.dirty = true;
+    } else {
+        Compact(id);
+    }
 
-    return listeners.size() - 1;
+    return handle;
 }
 
 void EventSystem::UnregisterListener(EventID id, ListenerID listenerId) {
-    auto& listeners = this->mEventListeners[id];
+    uint16_t slot = LISTENER_SLOT(listenerId);
+
+    if (slot >= this->mListenerSlots.size()) {
+        return;
+    }
+
+    auto& listenerSlot = this->mListenerSlots[slot];
+    if (!listenerSlot.used || listenerSlot.event != id || listenerSlot.generation != LISTENER_GENERATION(listenerId)) {
+        return;
+    }
+
+    listenerSlot.used = false;
+    listenerSlot.generation++;
+    this->mFreeListenerSlots.push_back(slot);
+
+    auto& event = this->mEventListeners[id];
+    auto it = std::find_if(event.listeners.begin(), event.listeners.end(),
+                           [listenerId](const RegisteredListener& entry) { return entry.handle == listenerId; });
+
+    if (it == event.listeners.end()) {
+        return;
+    }
 
-    listeners.erase(listeners.begin() + listenerId);
+    if (event.dispatchDepth > 0) {
+        it->listener.function = nullptr;
+        event.dirty = true;
+    } else {
+        event.listeners.erase(it);
+        UpdateMask(id);
+    }
 }
 
 void EventSystem::CallEvent(EventID id, IEvent* event) {
-    auto& listeners = this->mEventListeners[id];
+    if (id >= MAX_EVENTS) {
+        return;
+    }
+
+    auto& entry = this->mEventListeners[id];
+    // Listeners registered by a callback only take part in the next dispatch
+    size_t count = entry.listeners.size();
+
+    entry.dispatchDepth++;
+    for (size_t i = 0; i < count; i++) {
+        EventCallback function = entry.listeners[i].listener.function;
+        if (function != nullptr) {
+            function(event);
+        }
+    }
+    entry.dispatchDepth--;
 
-    for (auto& listener : listeners) {
-        listener.function(event);
+    if (entry.dispatchDepth == 0 && entry.dirty) {
+        Compact(id);
+    }
+}
+
+void EventSystem::Compact(EventID id) {
+    auto& event = this->mEventListeners[id];
+
+    std::erase_if(event.listeners, [](const RegisteredListener& entry) { return entry.listener.function == nullptr; });
+
+    // Sort by priority, keeping registration order between equal priorities
+    std::stable_sort(event.listeners.begin(), event.listeners.end(),
+                     [](const RegisteredListener& a, const RegisteredListener& b) {
+                         return a.listener.priority < b.listener.priority;
+                     });
+
+    event.dirty = false;
+    UpdateMask(id);
+}
+
+void EventSystem::UpdateMask(EventID id) {
+    uint64_t bit = 1ULL << (id % 64);
+
+    if (this->mEventListeners[id].listeners.empty()) {
+        gEventListenerMask[id / 64] &= ~bit;
+    } else {
+        gEventListenerMask[id / 64] |= bit;
     }
 }
 
@@ -49,14 +145,14 @@ extern "C" EventID EventSystem_RegisterEvent() {
     return EventSystem::Instance->RegisterEvent();
 }
 
-extern "C" size_t EventSystem_RegisterListener(EventID id, EventCallback callback, EventPriority priority) {
+extern "C" ListenerID EventSystem_RegisterListener(EventID id, EventCallback callback, EventPriority priority) {
     return EventSystem::Instance->RegisterListener(id, callback, priority);
 }
 
-extern "C" void EventSystem_UnregisterListener(EventID ev, size_t id) {
+extern "C" void EventSystem_UnregisterListener(EventID ev, ListenerID id) {
     EventSystem::Instance->UnregisterListener(ev, id);
 }
 
 extern "C" void EventSystem_CallEvent(EventID id, void* event) {
     EventSystem::Instance->CallEvent(id, static_cast<IEvent*>(event));
-}
\ No newline at end of file
+}
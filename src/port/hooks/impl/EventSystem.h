@@ -40,13 +40,32 @@ typedef struct {
     \
     DECLARE_EVENT(eventName)
 
+// Events without listeners are skipped inline, so hooks on hot paths cost a bit test.
+#define MAX_EVENTS 256
+#define EVENT_MASK_WORDS (MAX_EVENTS / 64)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern uint64_t gEventListenerMask[EVENT_MASK_WORDS];
+#ifdef __cplusplus
+}
+#endif
+
+#define EventSystem_HasListeners(id) \
+    ((id) < MAX_EVENTS && ((gEventListenerMask[(id) / 64] >> ((id) % 64)) & 1))
+
 #define CALL_EVENT(eventType, ...) \
     eventType eventType##_ = { {false}, __VA_ARGS__ }; \
-    EventSystem_CallEvent(eventType##ID, &eventType##_);
+    if (EventSystem_HasListeners(eventType##ID)) { \
+        EventSystem_CallEvent(eventType##ID, &eventType##_); \
+    }
 
 #define CALL_CANCELLABLE_EVENT(eventType, ...) \
     eventType eventType##_ = { {false}, __VA_ARGS__ }; \
-    EventSystem_CallEvent(eventType##ID, &eventType##_); \
+    if (EventSystem_HasListeners(eventType##ID)) { \
+        EventSystem_CallEvent(eventType##ID, &eventType##_); \
+    } \
     if (!eventType##_.event.cancelled)
 
 #define CHECK_IF_NOT_CANCELLED(eventType) \
@@ -54,7 +73,9 @@ typedef struct {
 
 #define CALL_CANCELLABLE_RETURN_EVENT(eventType, ...) \
     eventType eventType##_ = { {false}, __VA_ARGS__ }; \
-    EventSystem_CallEvent(eventType##ID, &eventType##_); \
+    if (EventSystem_HasListeners(eventType##ID)) { \
+        EventSystem_CallEvent(eventType##ID, &eventType##_); \
+    } \
     if (eventType##_.event.cancelled) { \
         return; \
     }
@@ -68,7 +89,6 @@ typedef struct {
 #ifdef __cplusplus
 #include <array>
 #include <vector>
-#include <unordered_map>
 
 class EventSystem {
 public:
@@ -78,7 +98,31 @@ public:
     void UnregisterListener(EventID ev, ListenerID id);
     void CallEvent(EventID id, IEvent* event);
 private:
-    std::unordered_map<EventID, std::vector<EventListener>> mEventListeners;
+    struct RegisteredListener {
+        EventListener listener;
+        ListenerID handle;
+    };
+
+    struct EventListeners {
+        // Sorted by priority. Entries removed while the event is dispatching are cleared and compacted afterwards.
+        std::vector<RegisteredListener> listeners;
+        uint32_t dispatchDepth = 0;
+        bool dirty = false;
+    };
+
+    // Listener handles pack a slot index with the slot's generation, so a stale handle never matches a newer listener.
+    struct ListenerSlot {
+        EventID event;
+        uint16_t generation;
+        bool used;
+    };
+
+    void Compact(EventID id);
+    void UpdateMask(EventID id);
+
+    std::array<EventListeners, MAX_EVENTS> mEventListeners;
+    std::vector<ListenerSlot> mListenerSlots;
+    std::vector<uint16_t> mFreeListenerSlots;
     EventID mInternalEventID = 0;
 };
 #else
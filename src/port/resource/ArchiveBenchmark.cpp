@@ -0,0 +1,353 @@
+#include "ArchiveBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "libultraship/src/Context.h"
+#include "libultraship/src/resource/ResourceManager.h"
+#include "libultraship/src/resource/ResourceLoader.h"
+#include "libultraship/src/resource/File.h"
+#include "libultraship/src/resource/archive/ArchiveCompression.h"
+#include "libultraship/src/resource/archive/ArchiveManager.h"
+#include "libultraship/src/resource/archive/MappedArchive.h"
+#include "StringHelper.h"
+#include <spdlog/spdlog.h>
+
+namespace {
+
+// Keeps the byte sums of LoadAll from being optimized out
+volatile size_t sChecksum = 0;
+
+std::shared_ptr<Ship::Archive> FindGameArchive() {
+    auto archives = Ship::Context::GetInstance()->GetResourceManager()->GetArchiveManager()->GetArchives();
+
+    for (const auto& archive : *archives) {
+        if (archive->GetPath().ends_with("sf64.o2r") || archive->GetPath().ends_with("sf64.o2m")) {
+            return archive;
+        }
+    }
+    return archives->empty() ? nullptr : archives->front();
+}
+
+// Resident set size of the process in bytes, 0 where it can't be read
+size_t GetResidentSetSize() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    if (statm >> pages >> resident) {
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
+
+// Loads every file of the archive and reads all of its bytes, like a factory parsing it would
+size_t LoadAll(const std::shared_ptr<Ship::Archive>& archive, std::vector<std::shared_ptr<Ship::File>>& files) {
+    size_t checksum = 0;
+
+    for (const auto& entry : *archive->ListFiles()) {
+        auto file = archive->LoadFile(entry.first);
+        if (file == nullptr) {
+            continue;
+        }
+
+        const char* data = file->GetData();
+        for (size_t i = 0; i < file->GetSize(); i++) {
+            checksum += static_cast<uint8_t>(data[i]);
+        }
+        files.push_back(file);
+    }
+    return checksum;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Loads the given files with threadCount threads sharing one queue, returns the time taken in milliseconds
+double TimeParallelLoad(const std::shared_ptr<Ship::Archive>& archive, const std::vector<uint64_t>& hashes,
+                        size_t threadCount, size_t* bytesLoaded) {
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> bytes = 0;
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&]() {
+            size_t index;
+            while ((index = next++) < hashes.size()) {
+                auto file = archive->LoadFile(hashes[index]);
+                if (file != nullptr) {
+                    bytes += file->GetSize();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    *bytesLoaded = bytes;
+    return MillisecondsSince(start);
+}
+
+} // namespace
+
+int32_t ArchiveBenchmark_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                 std::string* output) {
+    auto archive = FindGameArchive();
+    if (archive == nullptr) {
+        if (output) {
+            *output += "No archive loaded.";
+        }
+        return 1;
+    }
+
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (args.size() > 1) {
+        try {
+            maxThreads = std::clamp<size_t>(std::stoul(args[1]), 1, 64);
+        } catch (const std::exception&) {
+            if (output) {
+                *output += "Thread count must be a number.";
+            }
+            return 1;
+        }
+    }
+
+    std::vector<uint64_t> hashes;
+    for (const auto& entry : *archive->ListFiles()) {
+        hashes.push_back(entry.first);
+    }
+
+    if (output) {
+        *output += StringHelper::Sprintf("Loading %zu files from %s\n", hashes.size(), archive->GetPath().c_str());
+    }
+
+    for (size_t threadCount = 1; threadCount <= maxThreads; threadCount++) {
+        size_t bytes = 0;
+        double seconds = TimeParallelLoad(archive, hashes, threadCount, &bytes) / 1000.0;
+
+        if (output) {
+            *output += StringHelper::Sprintf("%2zu threads: %8.1f ms, %7.1f MB/s\n", threadCount, seconds * 1000.0,
+                                             bytes / (1024.0 * 1024.0) / seconds);
+        }
+    }
+
+    return 0;
+}
+
+int32_t ArchiveConvert_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                               std::string* output) {
+    auto archive = FindGameArchive();
+    if (archive == nullptr || !archive->GetPath().ends_with(".o2r")) {
+        if (output) {
+            *output += "sf64.o2r is not loaded.";
+        }
+        return 1;
+    }
+
+    std::string outputPath = std::filesystem::path(archive->GetPath()).replace_extension(".o2m").string();
+    auto start = std::chrono::steady_clock::now();
+    if (!Ship::MappedArchive::Convert(archive, outputPath)) {
+        if (output) {
+            *output += "Conversion failed, see the log for details.";
+        }
+        return 1;
+    }
+
+    if (output) {
+        *output += StringHelper::Sprintf("Wrote %s in %.1f ms, it will be used on the next start.",
+                                         outputPath.c_str(), MillisecondsSince(start));
+    }
+    return 0;
+}
+
+int32_t ArchiveStartup_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                               std::string* output) {
+    auto loaded = FindGameArchive();
+    if (loaded == nullptr) {
+        if (output) {
+            *output += "No archive loaded.";
+        }
+        return 1;
+    }
+
+    std::filesystem::path path = loaded->GetPath();
+    for (const char* extension : { ".o2r", ".o2m" }) {
+        std::string archivePath = std::filesystem::path(path).replace_extension(extension).string();
+        if (!std::filesystem::exists(archivePath)) {
+            continue;
+        }
+
+        // A fresh instance so nothing is shared with the archive the game is using
+        auto archive = Ship::ArchiveManager::CreateArchive(archivePath);
+        std::vector<std::shared_ptr<Ship::File>> files;
+        size_t rssBefore = GetResidentSetSize();
+
+        auto start = std::chrono::steady_clock::now();
+        if (!archive->Open()) {
+            continue;
+        }
+        double openTime = MillisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        sChecksum = sChecksum + LoadAll(archive, files);
+        double coldTime = MillisecondsSince(start);
+        size_t rssLoaded = GetResidentSetSize();
+
+        std::vector<std::shared_ptr<Ship::File>> warmFiles;
+        start = std::chrono::steady_clock::now();
+        sChecksum = sChecksum + LoadAll(archive, warmFiles);
+        double warmTime = MillisecondsSince(start);
+        size_t fileCount = files.size();
+
+        warmFiles.clear();
+        files.clear();
+        archive->Close();
+
+        if (output) {
+            *output += StringHelper::Sprintf("%s: open %.1f ms, first load %.1f ms, second load %.1f ms, %zu files",
+                                             archivePath.c_str(), openTime, coldTime, warmTime, fileCount);
+            if (rssBefore != 0) {
+                *output += StringHelper::Sprintf(", RSS +%.1f MB with every file loaded",
+                                                 (static_cast<double>(rssLoaded) - rssBefore) / (1024.0 * 1024.0));
+            }
+            *output += "\n";
+        }
+    }
+
+    return 0;
+}
+
+int32_t ArchiveCompression_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                   std::string* output) {
+    auto loaded = FindGameArchive();
+    if (loaded == nullptr || !loaded->GetPath().ends_with(".o2r")) {
+        if (output) {
+            *output += "sf64.o2r is not loaded.";
+        }
+        return 1;
+    }
+
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (auto compression : { Ship::ArchiveCompression::Deflate, Ship::ArchiveCompression::Zstd }) {
+        const char* name = Ship::GetArchiveCompressionName(compression);
+        if (!Ship::IsArchiveCompressionSupported(compression)) {
+            if (output) {
+                *output += StringHelper::Sprintf("%s: not supported by this build of libzip\n", name);
+            }
+            continue;
+        }
+
+        // Work on a copy, the loaded archive stays untouched
+        std::filesystem::path copyPath =
+            std::filesystem::temp_directory_path() / StringHelper::Sprintf("sf64-%s.o2r", name);
+        std::error_code error;
+        std::filesystem::copy_file(loaded->GetPath(), copyPath, std::filesystem::copy_options::overwrite_existing,
+                                   error);
+        if (error) {
+            if (output) {
+                *output += StringHelper::Sprintf("%s: failed to copy the archive: %s\n", name, error.message().c_str());
+            }
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool recompressed = Ship::RecompressArchive(copyPath.string(), compression);
+        double encodeTime = MillisecondsSince(start);
+
+        auto archive = Ship::ArchiveManager::CreateArchive(copyPath.string());
+        if (recompressed && archive->Open()) {
+            std::vector<uint64_t> hashes;
+            for (const auto& entry : *archive->ListFiles()) {
+                hashes.push_back(entry.first);
+            }
+
+            size_t bytes = 0;
+            double serialTime = TimeParallelLoad(archive, hashes, 1, &bytes);
+            double parallelTime = TimeParallelLoad(archive, hashes, threadCount, &bytes);
+            archive->Close();
+
+            if (output) {
+                *output += StringHelper::Sprintf(
+                    "%s: %.1f MB, encoded in %.0f ms, full load %.1f ms on 1 thread, %.1f ms on %zu threads\n", name,
+                    std::filesystem::file_size(copyPath) / (1024.0 * 1024.0), encodeTime, serialTime, parallelTime,
+                    threadCount);
+            }
+        } else if (output) {
+            *output += StringHelper::Sprintf("%s: recompression failed, see the log for details\n", name);
+        }
+
+        archive = nullptr;
+        std::filesystem::remove(copyPath, error);
+    }
+
+    return 0;
+}
+
+int32_t ResourceParse_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                              std::string* output) {
+    auto archive = FindGameArchive();
+    if (archive == nullptr) {
+        if (output) {
+            *output += "No archive loaded.";
+        }
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, std::shared_ptr<Ship::File>>> files;
+    size_t bytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [hash, path] : *archive->ListFiles()) {
+        // Not resources
+        if (path == "version" || path.starts_with("manifests/")) {
+            continue;
+        }
+
+        auto file = archive->LoadFile(hash);
+        if (file != nullptr) {
+            bytes += file->GetSize();
+            files.emplace_back(path, file);
+        }
+    }
+    double readTime = MillisecondsSince(start);
+
+    auto loader = Ship::Context::GetInstance()->GetResourceManager()->GetResourceLoader();
+    size_t parsed = 0;
+    size_t failed = 0;
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& [path, file] : files) {
+        try {
+            if (loader->LoadResource(path, file) != nullptr) {
+                parsed++;
+            } else {
+                failed++;
+            }
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("Failed to parse {}: {}", path, e.what());
+            failed++;
+        }
+    }
+    double parseTime = MillisecondsSince(start);
+
+    if (output) {
+        *output += StringHelper::Sprintf("Read %zu files (%.1f MB) in %.1f ms, parsed %zu resources in %.1f ms",
+                                         files.size(), bytes / (1024.0 * 1024.0), readTime, parsed, parseTime);
+        if (failed != 0) {
+            *output += StringHelper::Sprintf(", %zu failed", failed);
+        }
+    }
+    return 0;
+}
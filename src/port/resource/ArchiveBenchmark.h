@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ship {
+class Console;
+}
+
+// Console command: archive_benchmark [threads]
+// Loads every file of the game archive once per thread count from 1 to threads and reports the throughput of
+// each pass.
+int32_t ArchiveBenchmark_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                 std::string* output);
+
+// Console command: archive_convert
+// Writes the loaded sf64.o2r as a memory-mapped sf64.o2m next to it, which is preferred on the next start.
+int32_t ArchiveConvert_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                               std::string* output);
+
+// Console command: archive_startup
+// Opens fresh instances of sf64.o2r and sf64.o2m and times opening them, a first and a second load of every file,
+// and the resident memory growth with every file loaded. Files already in the OS page cache aren't read from disk,
+// so the first load is only truly cold after the cache has been dropped.
+int32_t ArchiveStartup_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                               std::string* output);
+
+// Console command: archive_compression
+// Recompresses copies of sf64.o2r with deflate and zstd and reports the size and full-load time of each.
+int32_t ArchiveCompression_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                                   std::string* output);
+
+// Console command: resource_parse
+// Reads every resource of the game archive, then runs each through its factory without caching the result, and
+// reports the read and parse times separately. Resources that load children, like limbs, also pay for those.
+int32_t ResourceParse_Command(std::shared_ptr<Ship::Console> console, const std::vector<std::string>& args,
+                              std::string* output);
@@ -0,0 +1,53 @@
+#include <libultraship/bridge.h>
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include "AssetCache.h"
+
+/*
+Asset handle cache.
+
+Game code refers to assets through symbols such as `static const char aFoxDL[] = "__OTR__..."`, and passes
+them to LOAD_ASSET, gSPDisplayList, gSPVertex and friends every time an object is drawn. Going through
+the resource manager for each of those builds a std::string, hashes a ResourceIdentifier, takes the cache
+mutex and round-trips a future, only to return the same pointer as last frame.
+
+Symbols live at fixed addresses, so the first resolve of each one is remembered by address. The stored
+path is compared on every hit so a reused char buffer with a different path can't return a stale asset.
+Everything is dropped when the resource manager's cache generation moves. Tables are per thread, so no
+locking is needed on the hot path.
+*/
+
+namespace {
+
+struct AssetEntry {
+    std::string path;
+    void* data;
+};
+
+thread_local std::unordered_map<const char*, AssetEntry> sAssets;
+thread_local uint32_t sGeneration = 0;
+
+} // namespace
+
+extern "C" void* AssetCache_GetData(const char* path) {
+    uint32_t generation = ResourceGetCacheGeneration();
+
+    if (generation != sGeneration) {
+        sAssets.clear();
+        sGeneration = generation;
+    }
+
+    auto it = sAssets.find(path);
+    if (it != sAssets.end() && strcmp(it->second.path.c_str(), path) == 0) {
+        return it->second.data;
+    }
+
+    void* data = ResourceGetDataByName(path);
+    if (data != nullptr) {
+        sAssets.insert_or_assign(path, AssetEntry{ path, data });
+    }
+    return data;
+}
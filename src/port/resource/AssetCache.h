@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns the loaded data for an __OTR__ asset path, like ResourceGetDataByName. Each asset symbol is resolved
+// through the resource manager once and then served from a table keyed on the symbol's address until the
+// resource cache changes (unload, dirty or alternate assets toggle).
+void* AssetCache_GetData(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,170 @@
+#include <libultraship/bridge.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LevelManifest.h"
+#include "libultraship/src/Context.h"
+#include "libultraship/src/resource/ResourceManager.h"
+#include "libultraship/src/resource/File.h"
+#include "StringHelper.h"
+
+extern "C" {
+#include <sf64context.h>
+#include <sf64thread.h>
+}
+
+/*
+Level preload manifests.
+
+Levels load their textures, display lists, skeletons, animations and sound data the first time they are drawn
+or played, so the first frames of a stage stall on synchronous loads. A manifest lists every resource a level
+asked for during an earlier playthrough. Entering the level queues all of them on the resource manager's
+worker threads at low priority, which overlaps the loads with the fade and intro. Anything the game asks for
+before its turn is loaded right away as before, since synchronous loads run at the highest priority.
+
+With gDeveloperTools.TraceLevelAssets set, entering a level records every resource requested until the game
+leaves it, and merges the result into manifests/level_NN.txt in the user directory. Manifests can also ship in
+a mod archive under the same name; the one in the user directory wins.
+
+Entering a level also starts a new resource memory epoch and pins the level's manifest. With a budget set in
+gPerformance.ResourceBudgetMB, resources the current level hasn't used are unloaded once the cache grows past
+it, oldest first. The manifest keeps the level's own resources from being picked even before they are drawn.
+*/
+
+namespace {
+
+int32_t sTraceLevel = -1;
+bool sTraceReachedPlay = false;
+
+std::string GetManifestName(int32_t level) {
+    return StringHelper::Sprintf("manifests/level_%02d.txt", level);
+}
+
+std::vector<std::string> ParseManifest(const std::string& text) {
+    std::vector<std::string> paths;
+    std::istringstream stream(text);
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        paths.push_back(line);
+    }
+    return paths;
+}
+
+std::vector<std::string> ReadManifest(int32_t level) {
+    const std::string name = GetManifestName(level);
+
+    std::ifstream file(Ship::Context::GetPathRelativeToAppDirectory(name), std::ios::binary);
+    if (file.is_open()) {
+        std::stringstream text;
+        text << file.rdbuf();
+        return ParseManifest(text.str());
+    }
+
+    auto archiveFile = Ship::Context::GetInstance()->GetResourceManager()->GetArchiveManager()->LoadFile(name);
+    if (archiveFile != nullptr && archiveFile->IsLoaded) {
+        return ParseManifest(std::string(archiveFile->GetData(), archiveFile->GetSize()));
+    }
+    return {};
+}
+
+void WriteManifest(int32_t level, const std::vector<std::string>& traced) {
+    // Merged with the existing manifest so several playthroughs of different routes add up
+    std::vector<std::string> existing = ReadManifest(level);
+    std::set<std::string> paths(existing.begin(), existing.end());
+    paths.insert(traced.begin(), traced.end());
+
+    const std::filesystem::path path = Ship::Context::GetPathRelativeToAppDirectory(GetManifestName(level));
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SPDLOG_ERROR("Failed to write level manifest {}", path.string());
+        return;
+    }
+
+    file << "# Resources used by level " << level << ", recorded with gDeveloperTools.TraceLevelAssets\n";
+    for (const auto& resourcePath : paths) {
+        file << resourcePath << '\n';
+    }
+    SPDLOG_INFO("Level {} manifest: {} resources traced, {} in {}", level, traced.size(), paths.size(), path.string());
+}
+
+void StopTrace() {
+    if (sTraceLevel < 0) {
+        return;
+    }
+
+    WriteManifest(sTraceLevel, Ship::Context::GetInstance()->GetResourceManager()->StopAccessTrace());
+    sTraceLevel = -1;
+}
+
+} // namespace
+
+extern "C" void LevelManifest_EnterLevel(int32_t level) {
+    auto resourceManager = Ship::Context::GetInstance()->GetResourceManager();
+
+    // A level being entered again after a retry or continue is still being traced
+    if (sTraceLevel == level) {
+        return;
+    }
+    StopTrace();
+
+    std::vector<std::string> paths = ReadManifest(level);
+    resourceManager->BeginMemoryEpoch();
+    resourceManager->SetPinnedResources(paths);
+
+    if (CVarGetInteger("gDeveloperTools.TraceLevelAssets", 0)) {
+        resourceManager->StartAccessTrace();
+        sTraceLevel = level;
+        sTraceReachedPlay = false;
+        return;
+    }
+
+    if (!CVarGetInteger("gPerformance.LevelPreload", 1)) {
+        return;
+    }
+
+    for (const auto& path : paths) {
+        resourceManager->LoadResourceAsync(path, false, BS::pr::low);
+    }
+
+    if (!paths.empty()) {
+        SPDLOG_INFO("Preloading {} resources for level {}", paths.size(), level);
+    }
+}
+
+extern "C" void LevelManifest_Update(void) {
+    auto resourceManager = Ship::Context::GetInstance()->GetResourceManager();
+    resourceManager->SetMemoryBudget((size_t)CVarGetInteger("gPerformance.ResourceBudgetMB", 0) * 1024 * 1024);
+    resourceManager->EnforceMemoryBudget();
+
+    if (sTraceLevel < 0) {
+        return;
+    }
+
+    // Play_Setup runs before the game switches to the play state, so only leaving it ends the trace
+    if (gGameState == GSTATE_PLAY) {
+        sTraceReachedPlay = true;
+    } else if (sTraceReachedPlay) {
+        StopTrace();
+        return;
+    }
+
+    if (!CVarGetInteger("gDeveloperTools.TraceLevelAssets", 0)) {
+        StopTrace();
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Called from Play_Setup when a level is entered. Queues the level's manifest for background loading, or starts
+// recording a new one when tracing is enabled.
+void LevelManifest_EnterLevel(int32_t level);
+
+// Called once per frame. Keeps the resource cache within its memory budget, and ends the running trace when the
+// game leaves the level and writes the manifest.
+void LevelManifest_Update(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,30 +10,24 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryAnimV0::ReadResource(std::
     }
 
     auto anim = std::make_shared<Animation>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    int16_t frameCount = reader->ReadInt16();
-    int16_t limbCount  = reader->ReadInt16();
+    int16_t frameCount = reader.ReadInt16();
+    int16_t limbCount  = reader.ReadInt16();
 
-    auto jointSize = reader->ReadUInt32();
+    auto jointSize = reader.ReadUInt32();
 
-    SPDLOG_INFO("JointSize: {}", jointSize);
+    SPDLOG_DEBUG("JointSize: {}", jointSize);
 
-    for (uint32_t i = 0; i < jointSize; i++) {
-        uint16_t xLen = reader->ReadUInt16();
-        uint16_t x    = reader->ReadUInt16();
-        uint16_t yLen = reader->ReadUInt16();
-        uint16_t y    = reader->ReadUInt16();
-        uint16_t zLen = reader->ReadUInt16();
-        uint16_t z    = reader->ReadUInt16();
-        anim->jointKey.push_back({xLen, x, yLen, y, zLen, z});
-    }
+    // JointKey is six packed u16s, so both arrays are read in one go
+    static_assert(sizeof(JointKey) == 6 * sizeof(uint16_t));
+    auto jointKeys = reader.ReadArray<uint16_t>((size_t)jointSize * 6);
+    anim->jointKey.resize(jointSize);
+    memcpy(anim->jointKey.data(), jointKeys.data(), jointKeys.size() * sizeof(uint16_t));
 
-    auto frameSize = reader->ReadUInt32();
+    auto frameSize = reader.ReadUInt32();
 
-    for (uint32_t i = 0; i < frameSize; i++) {
-        anim->frameData.push_back(reader->ReadInt16());
-    }
+    anim->frameData = reader.ReadArray<uint16_t>(frameSize);
 
     anim->mData.frameCount = frameCount;
     anim->mData.limbCount  = limbCount;
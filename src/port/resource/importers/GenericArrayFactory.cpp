@@ -1,8 +1,22 @@
 #include "GenericArrayFactory.h"
 #include "../type/GenericArray.h"
 #include "spdlog/spdlog.h"
+#include <stdexcept>
 
 namespace SF64 {
+
+// Every element type is a scalar or a packed vector of one scalar type, so the whole array is read in one
+// go as count * components scalars
+template <typename T>
+static void ReadElements(Ship::SpanReader& reader, std::vector<uint8_t>& data, size_t count) {
+    if (count > reader.GetRemaining() / sizeof(T)) {
+        throw std::out_of_range("GenericArray: count past the end of the file");
+    }
+
+    data.resize(count * sizeof(T));
+    reader.ReadArray(reinterpret_cast<T*>(data.data()), count);
+}
+
 std::shared_ptr<Ship::IResource> ResourceFactoryBinaryGenericArrayV0::ReadResource(std::shared_ptr<Ship::File> file,
                                                                                    std::shared_ptr<Ship::ResourceInitData> initData) {
     if (!FileHasValidFormatAndReader(file, initData)) {
@@ -10,99 +24,72 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryGenericArrayV0::ReadResour
     }
 
     auto arr = std::make_shared<GenericArray>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    auto type = reader->ReadUInt32();
+    auto type = reader.ReadUInt32();
 
-    SPDLOG_INFO("GenericArray Type Num: {}", type);
+    SPDLOG_DEBUG("GenericArray Type Num: {}", type);
 
-    auto count = reader->ReadUInt32();
+    auto count = reader.ReadUInt32();
 
-    SPDLOG_INFO("GenericArray Count: {}", count);
+    SPDLOG_DEBUG("GenericArray Count: {}", count);
 
-    for (uint32_t i = 0; i < count; i++) {
-        switch (static_cast<ArrayType>(type)) {
-            case ArrayType::u8: {
-                auto x = reader->ReadUByte();
-                arr->mData.push_back(x);
-                break;
-            }
-            case ArrayType::s8: {
-                auto x = reader->ReadInt8();
-                arr->mData.push_back(x);
-                break;
-            }
-            case ArrayType::u16: {
-                auto x = reader->ReadUInt16();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 2, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::s16: {
-                auto x = reader->ReadInt16();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 2, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::u32: {
-                auto x = reader->ReadUInt32();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::s32: {
-                auto x = reader->ReadInt32();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::u64: {
-                auto x = reader->ReadUInt64();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 8, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::f32: {
-                auto x = reader->ReadFloat();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::f64: {
-                auto x = reader->ReadDouble();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 8, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec2f: {
-                Vec2f vec(reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec2f), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3f: {
-                Vec3f vec(reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3f), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3s: {
-                Vec3s vec(reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3s), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3i: {
-                Vec3i vec(reader->ReadInt32(), reader->ReadInt32(), reader->ReadInt32());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3i), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3iu: {
-                Vec3iu vec(reader->ReadUInt32(), reader->ReadUInt32(), reader->ReadUInt32());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3iu), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec4f: {
-                Vec4f vec(reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec4f), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec4s: {
-                Vec4s vec(reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec4s), std::back_inserter(arr->mData));
-                break;
-            }
-        }
+    switch (static_cast<ArrayType>(type)) {
+        case ArrayType::u8:
+            ReadElements<uint8_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::s8:
+            ReadElements<int8_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::u16:
+            ReadElements<uint16_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::s16:
+            ReadElements<int16_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::u32:
+            ReadElements<uint32_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::s32:
+            ReadElements<int32_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::u64:
+            ReadElements<uint64_t>(reader, arr->mData, count);
+            break;
+        case ArrayType::f32:
+            ReadElements<float>(reader, arr->mData, count);
+            break;
+        case ArrayType::f64:
+            ReadElements<double>(reader, arr->mData, count);
+            break;
+        case ArrayType::Vec2f:
+            static_assert(sizeof(Vec2f) == 2 * sizeof(float));
+            ReadElements<float>(reader, arr->mData, (size_t)count * 2);
+            break;
+        case ArrayType::Vec3f:
+            static_assert(sizeof(Vec3f) == 3 * sizeof(float));
+            ReadElements<float>(reader, arr->mData, (size_t)count * 3);
+            break;
+        case ArrayType::Vec3s:
+            static_assert(sizeof(Vec3s) == 3 * sizeof(int16_t));
+            ReadElements<int16_t>(reader, arr->mData, (size_t)count * 3);
+            break;
+        case ArrayType::Vec3i:
+            static_assert(sizeof(Vec3i) == 3 * sizeof(int32_t));
+            ReadElements<int32_t>(reader, arr->mData, (size_t)count * 3);
+            break;
+        case ArrayType::Vec3iu:
+            static_assert(sizeof(Vec3iu) == 3 * sizeof(uint32_t));
+            ReadElements<uint32_t>(reader, arr->mData, (size_t)count * 3);
+            break;
+        case ArrayType::Vec4f:
+            static_assert(sizeof(Vec4f) == 4 * sizeof(float));
+            ReadElements<float>(reader, arr->mData, (size_t)count * 4);
+            break;
+        case ArrayType::Vec4s:
+            static_assert(sizeof(Vec4s) == 4 * sizeof(int16_t));
+            ReadElements<int16_t>(reader, arr->mData, (size_t)count * 4);
+            break;
     }
 
     return arr;
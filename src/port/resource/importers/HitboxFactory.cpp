@@ -10,13 +10,11 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryHitboxV0::ReadResource(std
     }
 
     auto hitbox = std::make_shared<Hitbox>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    auto count = reader->ReadUInt32();
+    auto count = reader.ReadUInt32();
 
-    for (uint32_t i = 0; i < count; i++) {
-        hitbox->mHitbox.push_back(reader->ReadFloat());
-    }
+    hitbox->mHitbox = reader.ReadArray<float>(count);
 
     return hitbox;
 }
@@ -14,20 +14,20 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryLimbV0::ReadResource(std::
     }
 
     auto limb = std::make_shared<Limb>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
-       
-    uint64_t dlist = reader->ReadUInt64();
-    limb->mData.dList = LoadChild<Gfx*>(dlist);
-    limb->mData.trans.x = reader->ReadFloat();
-    limb->mData.trans.y = reader->ReadFloat();
-    limb->mData.trans.z = reader->ReadFloat();
-
-    limb->mData.rot.x = reader->ReadInt16();
-    limb->mData.rot.y = reader->ReadInt16();
-    limb->mData.rot.z = reader->ReadInt16();
-
-    limb->mData.sibling = LoadChild<LimbData*>(reader->ReadUInt64());
-    limb->mData.child = LoadChild<LimbData*>(reader->ReadUInt64());
+    auto reader = CreateSpanReader(file, initData);
+
+    uint64_t dlist = reader.ReadUInt64();
+    limb->mData.dList = LoadChild<Gfx*>(limb, dlist);
+    limb->mData.trans.x = reader.ReadFloat();
+    limb->mData.trans.y = reader.ReadFloat();
+    limb->mData.trans.z = reader.ReadFloat();
+
+    limb->mData.rot.x = reader.ReadInt16();
+    limb->mData.rot.y = reader.ReadInt16();
+    limb->mData.rot.z = reader.ReadInt16();
+
+    limb->mData.sibling = LoadChild<LimbData*>(limb, reader.ReadUInt64());
+    limb->mData.child = LoadChild<LimbData*>(limb, reader.ReadUInt64());
 
     return limb;
 }
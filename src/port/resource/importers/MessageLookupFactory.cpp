@@ -19,7 +19,7 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryMessageLookupV0::ReadResou
         auto id = reader->ReadInt32();
         auto crc = reader->ReadUInt64();
 
-        uint16_t* ptr = LoadChild<uint16_t*>(crc);
+        uint16_t* ptr = LoadChild<uint16_t*>(table, crc);
         const char* name = ResourceGetNameByCrc(crc);
         table->mLookupTable.push_back({ id, ptr, strdup(name) });
     }
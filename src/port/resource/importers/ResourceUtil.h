@@ -5,7 +5,9 @@
 #include "Context.h"
 
 namespace SF64 {
-template <typename T> T LoadChild(uint64_t crc) {
+// Loads a resource another one points into. The parent keeps it loaded, so the memory budget can't unload a
+// child out from under a raw pointer the parent holds.
+template <typename T> T LoadChild(const std::shared_ptr<Ship::IResource>& parent, uint64_t crc) {
     if (crc == 0) {
         return nullptr;
     }
@@ -14,6 +16,10 @@ template <typename T> T LoadChild(uint64_t crc) {
         return nullptr;
     }
     auto asset = Ship::Context::GetInstance()->GetResourceManager()->LoadResourceProcess(path);
-    return asset != nullptr ? static_cast<T>(asset->GetRawPointer()) : nullptr;
+    if (asset == nullptr) {
+        return nullptr;
+    }
+    parent->AddDependency(asset);
+    return static_cast<T>(asset->GetRawPointer());
 }
 }
\ No newline at end of file
@@ -16,7 +16,7 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryScriptV0::ReadResource(std
     auto size = reader->ReadUInt32();
 
     for (uint32_t i = 0; i < size; i++) {
-        script->mScripts.push_back(LoadChild<uint16_t*>(reader->ReadUInt64()));
+        script->mScripts.push_back(LoadChild<uint16_t*>(script, reader->ReadUInt64()));
     }
 
     return script;
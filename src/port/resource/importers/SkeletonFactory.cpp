@@ -16,7 +16,7 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinarySkeletonV0::ReadResource(s
 
     auto count = reader->ReadUInt32();
     for(size_t i = 0; i < count; i++) {
-        skel->mLimbs.push_back(LoadChild<LimbData*>(reader->ReadUInt64()));
+        skel->mLimbs.push_back(LoadChild<LimbData*>(skel, reader->ReadUInt64()));
     }
     skel->mLimbs.push_back(nullptr);
 
@@ -10,17 +10,16 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryVec3fV0::ReadResource(std:
     }
 
     auto vec = std::make_shared<Vec3fArray>(initData);
-    auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
+    auto reader = CreateSpanReader(file, initData);
 
-    auto vecCount = reader->ReadUInt32();
+    auto vecCount = reader.ReadUInt32();
 
-    SPDLOG_INFO("Vec3f Count: {}", vecCount);
+    SPDLOG_DEBUG("Vec3f Count: {}", vecCount);
 
+    auto values = reader.ReadArray<float>((size_t)vecCount * 3);
+    vec->mData.reserve(vecCount);
     for (uint32_t i = 0; i < vecCount; i++) {
-        auto x = reader->ReadFloat();
-        auto y = reader->ReadFloat();
-        auto z = reader->ReadFloat();
-        vec->mData.emplace_back(x, y, z);
+        vec->mData.emplace_back(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
     }
 
     return vec;
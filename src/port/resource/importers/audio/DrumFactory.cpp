@@ -15,10 +15,10 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryDrumV0::ReadResource(std::
     drum->mDrum.adsrDecayIndex = reader->ReadUByte();
     drum->mDrum.pan = reader->ReadUByte();
     drum->mDrum.isRelocated = reader->ReadUByte();
-    auto sample = LoadChild<SampleData*>(reader->ReadUInt64());
+    auto sample = LoadChild<SampleData*>(drum, reader->ReadUInt64());
     drum->mDrum.tunedSample.sample = sample;
     drum->mDrum.tunedSample.tuning = sample->tuning != 0.0f ? sample->tuning : reader->ReadFloat();
-    drum->mDrum.envelope = LoadChild<EnvelopePointData*>(reader->ReadUInt64());
+    drum->mDrum.envelope = LoadChild<EnvelopePointData*>(drum, reader->ReadUInt64());
     drum->mDrum.isRelocated = 1;
 
     return drum;
@@ -16,18 +16,18 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinaryInstrumentV0::ReadResource
     instrument->mInstrument.normalRangeLo = reader->ReadUByte();
     instrument->mInstrument.normalRangeHi = reader->ReadUByte();
     instrument->mInstrument.adsrDecayIndex = reader->ReadUByte();
-    instrument->mInstrument.envelope = LoadChild<EnvelopePointData*>(reader->ReadUInt64());
-    auto lowSample = LoadChild<SampleData*>(reader->ReadUInt64());
+    instrument->mInstrument.envelope = LoadChild<EnvelopePointData*>(instrument, reader->ReadUInt64());
+    auto lowSample = LoadChild<SampleData*>(instrument, reader->ReadUInt64());
     instrument->mInstrument.lowPitchTunedSample.sample = lowSample;
     instrument->mInstrument.lowPitchTunedSample.tuning =
         lowSample != nullptr && lowSample->tuning != 0.0f ? lowSample->tuning : reader->ReadFloat();
 
-    auto normalSample = LoadChild<SampleData*>(reader->ReadUInt64());
+    auto normalSample = LoadChild<SampleData*>(instrument, reader->ReadUInt64());
     instrument->mInstrument.normalPitchTunedSample.sample = normalSample;
     instrument->mInstrument.normalPitchTunedSample.tuning =
         normalSample != nullptr && normalSample->tuning != 0.0f ? normalSample->tuning : reader->ReadFloat();
 
-    auto highSample = LoadChild<SampleData*>(reader->ReadUInt64());
+    auto highSample = LoadChild<SampleData*>(instrument, reader->ReadUInt64());
     instrument->mInstrument.highPitchTunedSample.sample = highSample;
     instrument->mInstrument.highPitchTunedSample.tuning =
         highSample != nullptr && highSample->tuning != 0.0f ? highSample->tuning : reader->ReadFloat();
@@ -24,10 +24,21 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinarySampleV1::ReadResource(std
     sample->mSample.medium = reader->ReadUByte();
     sample->mSample.unk = reader->ReadUByte();
     sample->mSample.size = reader->ReadUInt32();
-    sample->mSample.loop = LoadChild<AdpcmLoopData*>(reader->ReadUInt64());
-    sample->mSample.book = LoadChild<AdpcmBookData*>(reader->ReadUInt64());
-    sample->mSample.sampleAddr = new uint8_t[sample->mSample.size];
-    reader->Read((char*) sample->mSample.sampleAddr, sample->mSample.size);
+    sample->mSample.loop = LoadChild<AdpcmLoopData*>(sample, reader->ReadUInt64());
+    sample->mSample.book = LoadChild<AdpcmBookData*>(sample, reader->ReadUInt64());
+    size_t offset = reader->GetBaseAddress();
+
+    // Samples that are played as stored point into the file when its memory outlives it, S16 samples are
+    // byteswapped and always get their own copy.
+    if (sample->mSample.codec != 2 && file->Storage != nullptr && file->Data != nullptr && offset <= file->Size &&
+        sample->mSample.size <= file->Size - offset) {
+        sample->mSample.sampleAddr = reinterpret_cast<uint8_t*>(file->Data + offset);
+        sample->mStorage = file->Storage;
+        reader->Seek(sample->mSample.size, Ship::SeekOffsetType::Current);
+    } else {
+        sample->mSample.sampleAddr = new uint8_t[sample->mSample.size];
+        reader->Read((char*) sample->mSample.sampleAddr, sample->mSample.size);
+    }
 
     if(sample->mSample.codec == 2){
         sample->mSample.medium = 2;
@@ -102,7 +113,7 @@ static void Mp3DecoderWorker(std::shared_ptr<Sample> sample, std::shared_ptr<Shi
     drmp3 mp3;
     drwav_uint64 numFrames;
     drmp3_bool32 ret =
-        drmp3_init_memory(&mp3, sampleFile->Buffer->data(), sampleFile->Buffer->size(), nullptr);
+        drmp3_init_memory(&mp3, sampleFile->GetData(), sampleFile->GetSize(), nullptr);
     numFrames = drmp3_get_pcm_frame_count(&mp3);
     drwav_uint64 channels = mp3.channels;
     drwav_uint64 sampleRate = mp3.sampleRate;
@@ -120,9 +131,9 @@ static void OggDecoderWorker(std::shared_ptr<Sample> sample, std::shared_ptr<Shi
     size_t pos = 0;
 
     OggFileData fileData = {
-        .data = sampleFile->Buffer.get()->data(),
+        .data = sampleFile->GetData(),
         .pos = 0,
-        .size = sampleFile->Buffer.get()->size(),
+        .size = sampleFile->GetSize(),
     };
     int ret = ov_open_callbacks(&fileData, &vf, nullptr, 0, vorbisCallbacks);
 
@@ -200,7 +211,7 @@ std::shared_ptr<Ship::IResource> ResourceFactoryXMLSampleV0::ReadResource(std::s
             drwav_uint64 numFrames;
 
             drwav_bool32 ret =
-                drwav_init_memory(&wav, sampleFile->Buffer->data(), sampleFile->Buffer->size(), nullptr);
+                drwav_init_memory(&wav, sampleFile->GetData(), sampleFile->GetSize(), nullptr);
 
             drwav_get_length_in_pcm_frames(&wav, &numFrames);
 
@@ -224,7 +235,7 @@ std::shared_ptr<Ship::IResource> ResourceFactoryXMLSampleV0::ReadResource(std::s
     sample->mSample.sampleAddr = new uint8_t[size];
     // Can't use memcpy due to endianness issues.
     for (uint32_t i = 0; i < size; i++) {
-        sample->mSample.sampleAddr[i] = (*sampleFile->Buffer)[i];
+        sample->mSample.sampleAddr[i] = sampleFile->GetData()[i];
     }
 
     sample->mSample.isRelocated = 1;
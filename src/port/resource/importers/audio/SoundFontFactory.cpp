@@ -21,11 +21,11 @@ std::shared_ptr<Ship::IResource> ResourceFactoryBinarySoundFontV0::ReadResource(
     font->mFont.sampleBankId2 = reader->ReadUByte();
 
     for(size_t i = 0; i < font->mFont.numInstruments; i++){
-        font->mInstruments.push_back(LoadChild<InstrumentData*>(reader->ReadUInt64()));
+        font->mInstruments.push_back(LoadChild<InstrumentData*>(font, reader->ReadUInt64()));
     }
 
     for(size_t i = 0; i < font->mFont.numDrums; i++){
-        font->mDrums.push_back(LoadChild<DrumData*>(reader->ReadUInt64()));
+        font->mDrums.push_back(LoadChild<DrumData*>(font, reader->ReadUInt64()));
     }
 
     font->mFont.instruments = font->mInstruments.data();
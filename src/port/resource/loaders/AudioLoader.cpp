@@ -8,12 +8,188 @@
 #include <filesystem>
 
 #ifdef OTR_AUDIO
+#include "libultraship/src/Context.h"
+#include "libultraship/src/resource/ResourceManager.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <spdlog/spdlog.h>
+
+/*  Background sound font loading.
+
+    A sound font resource converts its instruments, drums, envelopes and samples as it loads, so the first note of
+    a font used to stall the audio thread for the whole conversion. Starting a sequence queues its fonts on the
+    resource manager's worker threads from the game thread, and the audio thread only takes fonts that are already
+    loaded. A font that isn't in yet is reported as still loading, and the sequence waits for it instead of the
+    audio update.
+
+    The loads in flight are shared between both threads and never submitted twice, so a font is converted once no
+    matter who asks for it first. Fonts are queued ahead of a level's preload, since a sequence is waiting on them.
+    A font that fails to load is remembered and reported as not loaded from then on instead of being retried.
+
+    Waiting on the workers makes a sequence start a machine dependent number of updates late. Offline renders
+    turn on blocking loads so the same script always gives the same samples, and the sound effect and voice
+    players wait for their fonts when they start, since they run for the whole game. A note that still finds its
+    font missing is dropped, counted for the audio stats window and logged once per font.
+*/
+
+namespace {
+
+std::mutex sFontLoadMutex;
+std::unordered_map<uint32_t, std::shared_future<std::shared_ptr<Ship::IResource>>> sFontLoads;
+std::unordered_set<uint32_t> sFailedFonts;
+std::unordered_set<uint32_t> sMissingFonts;
+std::atomic<bool> sBlockingFontLoads = false;
+std::atomic<uint32_t> sDroppedNotes = 0;
+CVarHandle sFontPreloadCVar = nullptr;
+
+const char* GetFontPath(uint32_t fontId) {
+    if (fontId >= (uint32_t) gSoundFontTable->base.numEntries) {
+        return nullptr;
+    }
+    return ResourceGetNameByCrc((uint64_t) gSoundFontTable->entries[fontId].romAddr);
+}
+
+// Returns the font once it is loaded, otherwise makes sure it is being loaded. Never waits on the load.
+SoundFont* RequestFont(uint32_t fontId, BS::priority_t priority) {
+    auto resourceManager = Ship::Context::GetInstance()->GetResourceManager();
+    std::lock_guard<std::mutex> lock(sFontLoadMutex);
+
+    if (sFailedFonts.contains(fontId)) {
+        return nullptr;
+    }
+
+    const char* path = GetFontPath(fontId);
+    if (path == nullptr) {
+        sFailedFonts.insert(fontId);
+        return nullptr;
+    }
+
+    auto load = sFontLoads.find(fontId);
+    if (load == sFontLoads.end()) {
+        auto resource = resourceManager->GetCachedResource(path);
+        if (resource != nullptr) {
+            return (SoundFont*) resource->GetRawPointer();
+        }
+        sFontLoads.emplace(fontId, resourceManager->LoadResourceAsync(path, false, priority));
+        return nullptr;
+    }
+
+    if (load->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return nullptr;
+    }
+
+    auto resource = load->second.get();
+    sFontLoads.erase(load);
+    if (resource == nullptr) {
+        SPDLOG_ERROR("Failed to load sound font {} ({})", fontId, path);
+        sFailedFonts.insert(fontId);
+        return nullptr;
+    }
+    return (SoundFont*) resource->GetRawPointer();
+}
+
+// Returns the font, waiting for the load in flight if there is one or loading it on this thread otherwise
+SoundFont* WaitForFont(uint32_t fontId) {
+    std::shared_future<std::shared_ptr<Ship::IResource>> pending;
+    const char* path;
+    {
+        std::lock_guard<std::mutex> lock(sFontLoadMutex);
+        if (sFailedFonts.contains(fontId)) {
+            return nullptr;
+        }
+
+        path = GetFontPath(fontId);
+        if (path == nullptr) {
+            sFailedFonts.insert(fontId);
+            return nullptr;
+        }
+
+        auto load = sFontLoads.find(fontId);
+        if (load != sFontLoads.end()) {
+            pending = load->second;
+        }
+    }
+
+    // Not under the lock, the game thread keeps queueing fonts while this one loads
+    auto resource = pending.valid() ? pending.get()
+                                    : Ship::Context::GetInstance()->GetResourceManager()->LoadResource(path);
+
+    std::lock_guard<std::mutex> lock(sFontLoadMutex);
+    sFontLoads.erase(fontId);
+    if (resource == nullptr) {
+        SPDLOG_ERROR("Failed to load sound font {} ({})", fontId, path);
+        sFailedFonts.insert(fontId);
+        return nullptr;
+    }
+    return (SoundFont*) resource->GetRawPointer();
+}
+
+} // namespace
+
 extern "C" SoundFont* Audio_LoadFont(AudioTableEntry entry, uint32_t fontId) {
-    auto crc = (uint64_t) gSoundFontTable->entries[fontId].romAddr;
-    auto path = ResourceGetNameByCrc(crc);
-    // printf("Font: %s\n", path);
-  
-    return (SoundFont*) ResourceGetDataByCrc(crc);
+    if (sBlockingFontLoads || !CVarGetCachedInteger(&sFontPreloadCVar, "gPerformance.AudioFontPreload", 1)) {
+        return WaitForFont(fontId);
+    }
+
+    return RequestFont(fontId, BS::pr::highest);
+}
+
+extern "C" SoundFont* Audio_WaitForFont(uint32_t fontId) {
+    return WaitForFont(fontId);
+}
+
+extern "C" bool Audio_FontLoadFailed(uint32_t fontId) {
+    std::lock_guard<std::mutex> lock(sFontLoadMutex);
+    return sFailedFonts.contains(fontId);
+}
+
+extern "C" void Audio_SetFontLoadBlocking(bool blocking) {
+    sBlockingFontLoads = blocking;
+}
+
+extern "C" void Audio_ReportMissingFont(uint32_t fontId) {
+    sDroppedNotes++;
+
+    std::lock_guard<std::mutex> lock(sFontLoadMutex);
+    if (sMissingFonts.insert(fontId).second) {
+        SPDLOG_WARN("Dropped a note of sound font {}, the font is not loaded", fontId);
+    }
+}
+
+extern "C" uint32_t Audio_GetDroppedNoteCount(void) {
+    return sDroppedNotes;
+}
+
+extern "C" void Audio_PreloadFont(uint32_t fontId) {
+    if (CVarGetCachedInteger(&sFontPreloadCVar, "gPerformance.AudioFontPreload", 1)) {
+        RequestFont(fontId, BS::pr::high);
+    }
+}
+
+extern "C" void Audio_PreloadSequence(uint32_t seqId) {
+    if (!CVarGetCachedInteger(&sFontPreloadCVar, "gPerformance.AudioFontPreload", 1)) {
+        return;
+    }
+
+    if (seqId >= (uint32_t) gSequenceTable->base.numEntries) {
+        return;
+    }
+
+    s32 index = BSWAP16(*((u16*) gSeqFontTable + seqId));
+    s32 numFonts = gSeqFontTable[index++];
+
+    for (; numFonts > 0; numFonts--) {
+        RequestFont(gSeqFontTable[index++], BS::pr::high);
+    }
+
+    // The sequence itself is small and still loaded on the audio thread, this only gets it out of the archive early
+    const char* path = ResourceGetNameByCrc((uint64_t) gSequenceTable->entries[seqId].romAddr);
+    if (path != nullptr) {
+        Ship::Context::GetInstance()->GetResourceManager()->LoadResourceAsync(path, false, BS::pr::low);
+    }
 }
 #else
 namespace fs = std::filesystem;
@@ -10,7 +10,18 @@ extern "C" {
 #endif
 
 #ifdef OTR_AUDIO
+// Returns NULL while the font is still loading in the background, or when it failed to load
 SoundFont* Audio_LoadFont(AudioTableEntry entry, uint32_t fontId);
+SoundFont* Audio_WaitForFont(uint32_t fontId);
+bool Audio_FontLoadFailed(uint32_t fontId);
+// While set, Audio_LoadFont waits for fonts instead of returning NULL. Used by offline renders.
+void Audio_SetFontLoadBlocking(bool blocking);
+// Counts a note dropped because its font was not loaded yet, shown in the audio stats window
+void Audio_ReportMissingFont(uint32_t fontId);
+uint32_t Audio_GetDroppedNoteCount(void);
+// Queue a font, or a sequence and its fonts, for loading on the resource worker threads. Called from the game thread.
+void Audio_PreloadFont(uint32_t fontId);
+void Audio_PreloadSequence(uint32_t seqId);
 #else
 char* Audio_LoadBlob(const char* resource, u32 offset);
 AdpcmBook* Audio_LoadBook(uint32_t addr);
@@ -29,5 +29,7 @@ class Sample : public Ship::Resource<SampleData> {
     size_t GetPointerSize();
 
     SampleData mSample;
+    // Keeps the file alive when sampleAddr points into it
+    std::shared_ptr<void> mStorage;
 };
 }
\ No newline at end of file
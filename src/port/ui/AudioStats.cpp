@@ -0,0 +1,76 @@
+#include "AudioStats.h"
+#include "libultraship/src/Context.h"
+#include "libultraship/src/audio/Audio.h"
+#include "port/audio/SampleCache.h"
+#include "port/resource/loaders/AudioLoader.h"
+
+#include <imgui.h>
+
+/*  Shows how the audio player's queue tracks the latency set with gAudioLatency.
+
+    The queue level is sampled when a frame of audio is handed to the player, so it reads lower than the
+    true latency by up to a frame. Players without a latency controller only report the level.
+    The latency adds the device's own buffer to the queue, which is how long a sample synthesized now takes
+    to reach the speakers. A sound the game starts waits for the next audio update on top of that.
+    Below that, how much of the ADPCM decoding the decoded sample cache took over, and how many notes were
+    dropped because their sound font was still loading in the background.
+*/
+
+namespace AudioStats {
+    static float ToMilliseconds(int32_t samples, int32_t sampleRate) {
+        return sampleRate > 0 ? (float)samples * 1000.0f / (float)sampleRate : 0.0f;
+    }
+
+    void AudioStatsWindow::InitElement() {
+    }
+
+    void AudioStatsWindow::DrawElement() {
+        ImGui::SetNextWindowSize(ImVec2(320, 290), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Audio Stats", &mIsVisible)) {
+            ImGui::End();
+            return;
+        }
+
+        auto player = Ship::Context::GetInstance()->GetAudio()->GetAudioPlayer();
+        if (player == nullptr || !player->IsInitialized()) {
+            ImGui::Text("No audio player");
+            ImGui::End();
+            return;
+        }
+
+        const Ship::AudioPlayerStats stats = player->GetStats();
+        const int32_t sampleRate = player->GetSampleRate();
+
+        ImGui::Text("Buffered: %d samples (%.1f ms)", stats.Buffered, ToMilliseconds(stats.Buffered, sampleRate));
+        ImGui::Text("Target: %d samples (%.1f ms)", stats.TargetBuffered,
+                    ToMilliseconds(stats.TargetBuffered, sampleRate));
+        ImGui::ProgressBar(stats.TargetBuffered > 0 ? (float)stats.Buffered / (2.0f * stats.TargetBuffered) : 0.0f);
+        ImGui::Text("Underruns: %u", stats.Underruns);
+        ImGui::Text("Overruns: %u", stats.Overruns);
+        ImGui::Text("Rate correction: %+.3f%%", (stats.RateCorrection - 1.0f) * 100.0f);
+
+        const float latency =
+            ToMilliseconds(stats.Buffered, sampleRate) + ToMilliseconds(stats.DeviceBuffered, stats.DeviceSampleRate);
+        ImGui::Separator();
+        ImGui::Text("Latency: %.1f ms", latency);
+        if (stats.DeviceSampleRate > 0) {
+            ImGui::Text("Output: %d Hz, device %d Hz%s", sampleRate, stats.DeviceSampleRate,
+                        stats.DeviceSampleRate != sampleRate ? " (resampled)" : "");
+        } else {
+            ImGui::Text("Output: %d Hz", sampleRate);
+        }
+
+        SampleCacheStats cacheStats;
+        SampleCache_GetStats(&cacheStats);
+        const uint64_t decodes = cacheStats.Hits + cacheStats.Misses;
+        ImGui::Separator();
+        ImGui::Text("Decoded samples: %u (%.1f MB)", cacheStats.Samples, cacheStats.Bytes / (1024.0f * 1024.0f));
+        ImGui::Text("Decodes served: %.1f%%", decodes > 0 ? cacheStats.Hits * 100.0 / decodes : 0.0);
+        ImGui::Text("Notes dropped waiting on fonts: %u", Audio_GetDroppedNoteCount());
+
+        ImGui::End();
+    }
+
+    void AudioStatsWindow::UpdateElement() {
+    }
+} // namespace AudioStats
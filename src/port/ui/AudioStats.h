@@ -0,0 +1,13 @@
+#pragma once
+#include <libultraship/libultraship.h>
+
+namespace AudioStats {
+    class AudioStatsWindow : public Ship::GuiWindow {
+    public:
+        using Ship::GuiWindow::GuiWindow;
+
+        void InitElement() override;
+        void DrawElement() override;
+        void UpdateElement() override;
+    };
+} // namespace AudioStats
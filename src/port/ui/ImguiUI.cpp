@@ -1,8 +1,11 @@
 #include "ImguiUI.h"
 #include "UIWidgets.h"
 #include "ResolutionEditor.h"
+#include "ResourceMemory.h"
+#include "AudioStats.h"
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 #include <imgui.h>
@@ -309,6 +312,8 @@ std::shared_ptr<Ship::GuiWindow> mInputEditorWindow;
 std::shared_ptr<Ship::GuiWindow> mGfxDebuggerWindow;
 std::shared_ptr<Notification::Window> mNotificationWindow;
 std::shared_ptr<AdvancedResolutionSettings::AdvancedResolutionSettingsWindow> mAdvancedResolutionSettingsWindow;
+std::shared_ptr<ResourceMemory::ResourceMemoryWindow> mResourceMemoryWindow;
+std::shared_ptr<AudioStats::AudioStatsWindow> mAudioStatsWindow;
 
 void SetupGuiElements() {
     auto gui = Ship::Context::GetInstance()->GetWindow()->GetGui();
@@ -354,6 +359,10 @@ void SetupGuiElements() {
 
     mAdvancedResolutionSettingsWindow = std::make_shared<AdvancedResolutionSettings::AdvancedResolutionSettingsWindow>("gAdvancedResolutionEditorEnabled", "Advanced Resolution Settings");
     gui->AddGuiWindow(mAdvancedResolutionSettingsWindow);
+    mResourceMemoryWindow = std::make_shared<ResourceMemory::ResourceMemoryWindow>("gResourceMemoryEnabled", "Resource Memory");
+    gui->AddGuiWindow(mResourceMemoryWindow);
+    mAudioStatsWindow = std::make_shared<AudioStats::AudioStatsWindow>("gAudioStatsEnabled", "Audio Stats");
+    gui->AddGuiWindow(mAudioStatsWindow);
     mNotificationWindow = std::make_shared<Notification::Window>("gNotifications", "Notifications Window");
     gui->AddGuiWindow(mNotificationWindow);
     mNotificationWindow->Show();
@@ -364,6 +373,8 @@ void Destroy() {
     gui->RemoveAllGuiWindows();
 
     mAdvancedResolutionSettingsWindow = nullptr;
+    mResourceMemoryWindow = nullptr;
+    mAudioStatsWindow = nullptr;
     mConsoleWindow = nullptr;
     mStatsWindow = nullptr;
     mInputEditorWindow = nullptr;
@@ -561,6 +572,21 @@ void DrawSettingsMenu(){
                 UIWidgets::ReEnableComponent("");
             }
             
+            UIWidgets::CVarSliderInt("Audio Latency: %d ms", "gAudioLatency", 20, 200, 52, {
+                .tooltip = "How much audio is queued ahead of the speakers. Lower values respond faster, higher values "
+                           "ride out frame time spikes without crackling"
+            });
+
+            UIWidgets::CVarCheckbox("High Quality Reverb", "gAudioHighQualityReverb", {
+                .tooltip = "Runs the reverbs the game downsamples at the full output rate, so echoes keep their high "
+                           "frequencies. Takes effect on the next scene"
+            });
+
+            UIWidgets::CVarCheckbox("48 kHz Output (Needs reload)", "gAudioOutput48kHz", {
+                .tooltip = "Synthesizes the audio at 48 kHz instead of the N64's 32 kHz. Most devices run at 48 kHz, "
+                           "so the output no longer has to be resampled on its way to them"
+            });
+
             UIWidgets::PaddedEnhancementCheckbox("Surround 5.1 (Needs reload)", "gAudioChannelsSetting", 1, 0);
             
             if (CVarGetInteger("gAudioChannelsSetting", 0) == 1) {
@@ -1082,6 +1108,32 @@ static const char* logLevels[] = {
     "trace", "debug", "info", "warn", "error", "critical", "off",
 };
 
+static double sCVarLookupNs = 0.0;
+static double sCVarHandleNs = 0.0;
+
+// Times the per-read cost of a string lookup against a handle read on the same CVar
+static void BenchmarkCVarReads() {
+    constexpr int reads = 1000000;
+    const char* name = "gCockpitOpacity";
+    volatile int32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++) {
+        sink = sink + CVarGetInteger(name, 120);
+    }
+    auto lookupEnd = std::chrono::steady_clock::now();
+
+    CVarHandle handle = CVarGetHandle(name);
+    auto handleStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++) {
+        sink = sink + CVarHandleGetInteger(handle, 120);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    sCVarLookupNs = std::chrono::duration<double, std::nano>(lookupEnd - start).count() / reads;
+    sCVarHandleNs = std::chrono::duration<double, std::nano>(end - handleStart).count() / reads;
+}
+
 void DrawDebugMenu() {
     if (UIWidgets::BeginMenu("Developer")) {
         if (UIWidgets::CVarCombobox("Log Level", "gDeveloperTools.LogLevel", logLevels, {
@@ -1201,6 +1253,64 @@ void DrawDebugMenu() {
             }
         }
 
+        if (UIWidgets::BeginMenu("Performance")) {
+            UIWidgets::CVarCheckbox("Cache Animation Poses", "gPerformance.AnimationPoseCache", {
+                .tooltip = "Decode each animation frame once per game frame and share it between enemies using the same animation",
+                .defaultValue = true
+            });
+            UIWidgets::CVarCheckbox("Parallel Effect Updates", "gPerformance.ParallelEffects", {
+                .tooltip = "Simulate simple smoke, debris and explosion effects on worker threads during heavy scenes.\n"
+                           "Results are applied in the original order, so gameplay is unchanged"
+            });
+            UIWidgets::CVarCheckbox("Parallel Audio Synthesis", "gPerformance.ParallelAudio", {
+                .tooltip = "Synthesize the playing notes on worker threads when many of them play at once.\n"
+                           "They are mixed in the original order, so the sound is unchanged. Stereo output only"
+            });
+            UIWidgets::CVarCheckbox("Cache Decoded Samples", "gPerformance.SampleCache", {
+                .tooltip = "Decode short or often played sound samples once and reuse them instead of decoding them "
+                           "for every note. The sound is unchanged",
+                .defaultValue = true
+            });
+            UIWidgets::CVarCheckbox("Preload Sound Fonts", "gPerformance.AudioFontPreload", {
+                .tooltip = "Load the sound fonts of a sequence in the background when it is started. A note whose font "
+                           "is still loading is skipped instead of pausing the audio",
+                .defaultValue = true
+            });
+            UIWidgets::CVarCheckbox("Preload Level Assets", "gPerformance.LevelPreload", {
+                .tooltip = "Load the resources listed in a level's manifest in the background while the level starts",
+                .defaultValue = true
+            });
+            UIWidgets::CVarCheckbox("Trace Level Assets", "gDeveloperTools.TraceLevelAssets", {
+                .tooltip = "Record the resources each level uses and add them to manifests/level_NN.txt in the user "
+                           "directory when the level is left"
+            });
+            UIWidgets::CVarSliderInt("Resource Budget: %d MB", "gPerformance.ResourceBudgetMB", 0, 1024, 0, {
+                .tooltip = "Unload the resources the current level hasn't used, oldest first, once the resource cache "
+                           "grows past this size. 0 keeps everything loaded",
+                .step = 16
+            });
+            UIWidgets::WindowButton("Resource Memory", "gResourceMemoryEnabled", GameUI::mResourceMemoryWindow, {
+                .tooltip = "Shows how much memory each resource type uses and how many were unloaded"
+            });
+            UIWidgets::WindowButton("Audio Stats", "gAudioStatsEnabled", GameUI::mAudioStatsWindow, {
+                .tooltip = "Shows the audio buffer level against the latency target, underruns, overruns and the "
+                           "playback rate correction"
+            });
+
+            UIWidgets::Spacer(0);
+            ImGui::Text("Timer tasks: %u live, %u peak", Timer_GetLiveTaskCount(), Timer_GetPeakTaskCount());
+
+            UIWidgets::Spacer(0);
+            if (UIWidgets::Button("Benchmark CVar Reads")) {
+                BenchmarkCVarReads();
+            }
+            if (sCVarLookupNs > 0.0) {
+                ImGui::Text("CVar reads: %.2f ns by name, %.2f ns by handle", sCVarLookupNs, sCVarHandleNs);
+            }
+
+            ImGui::EndMenu();
+        }
+
         UIWidgets::Spacer(0);
 
         UIWidgets::WindowButton("Stats", "gStatsEnabled", GameUI::mStatsWindow, {
@@ -0,0 +1,80 @@
+#include "ResourceMemory.h"
+#include "libultraship/src/Context.h"
+#include "libultraship/src/resource/ResourceManager.h"
+
+#include <algorithm>
+#include <imgui.h>
+#include <string>
+#include <vector>
+
+/*  Shows what the resource cache holds against gPerformance.ResourceBudgetMB, per resource type.
+
+    Sizes are the larger of what each resource reports and the size of the file it was made from, so they
+    are estimates. Types pinned by the game, like the sound data, are counted but never unloaded.
+*/
+
+namespace ResourceMemory {
+    static float ToMegabytes(size_t bytes) {
+        return (float)bytes / (1024.0f * 1024.0f);
+    }
+
+    void ResourceMemoryWindow::InitElement() {
+    }
+
+    void ResourceMemoryWindow::DrawElement() {
+        ImGui::SetNextWindowSize(ImVec2(420, 400), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Resource Memory", &mIsVisible)) {
+            ImGui::End();
+            return;
+        }
+
+        auto resourceManager = Ship::Context::GetInstance()->GetResourceManager();
+        const size_t budget = resourceManager->GetMemoryBudget();
+
+        ImGui::Text("Resident: %.1f MB", ToMegabytes(resourceManager->GetResidentMemory()));
+        if (budget > 0) {
+            ImGui::Text("Budget: %.1f MB", ToMegabytes(budget));
+        } else {
+            ImGui::Text("Budget: off");
+        }
+        ImGui::Text("Epoch: %u", resourceManager->GetMemoryEpoch());
+
+        struct Row {
+            std::string Name;
+            Ship::ResourceMemoryStats Stats;
+        };
+        std::vector<Row> rows;
+        for (const auto& [type, stats] : resourceManager->GetMemoryStats()) {
+            if (stats.Count > 0 || stats.Evictions > 0) {
+                rows.push_back({ resourceManager->GetResourceLoader()->GetResourceTypeName(type), stats });
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.Stats.Bytes > b.Stats.Bytes; });
+
+        if (ImGui::BeginTable("ResourceMemoryTypes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("MB");
+            ImGui::TableSetupColumn("Unloaded");
+            ImGui::TableHeadersRow();
+
+            for (const auto& row : rows) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(row.Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", row.Stats.Count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", ToMegabytes(row.Stats.Bytes));
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", row.Stats.Evictions);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
+    void ResourceMemoryWindow::UpdateElement() {
+    }
+} // namespace ResourceMemory